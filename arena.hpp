@@ -0,0 +1,143 @@
+#ifndef ARENA_ARENA_HPP
+#define ARENA_ARENA_HPP
+
+#include <cstddef>
+#include <cstdint>
+#include <new>
+#include <algorithm>
+#include <type_traits>
+
+namespace my_container {
+
+    // Bump-pointer memory resource. Individual deallocations are ignored;
+    // reset() drops every allocation at once. Not thread-safe: give each
+    // worker thread (or each request) its own arena.
+    class MonotonicArena {
+    public:
+        explicit MonotonicArena(std::size_t initial_chunk = 4096)
+                : next_chunk_size_(std::max<std::size_t>(initial_chunk, 256)) {}
+
+        MonotonicArena(const MonotonicArena&) = delete;
+        MonotonicArena& operator=(const MonotonicArena&) = delete;
+
+        ~MonotonicArena() {
+            release();
+        }
+
+        void* allocate(std::size_t bytes, std::size_t align = alignof(std::max_align_t)) {
+            if (void* p = bump(bytes, align)) return p;
+            add_chunk(bytes + align);
+            return bump(bytes, align);
+        }
+
+        void deallocate(void*, std::size_t) noexcept {}
+
+        // Keeps the newest (largest) chunk for reuse and frees all others.
+        void reset() noexcept {
+            if (!chunks_) return;
+            Chunk* keep = chunks_;
+            free_chunks(keep->next);
+            keep->next = nullptr;
+            cur_ = payload(keep);
+            end_ = reinterpret_cast<char*>(keep) + keep->size;
+            used_ = 0;
+        }
+
+        void release() noexcept {
+            free_chunks(chunks_);
+            chunks_ = nullptr;
+            cur_ = end_ = nullptr;
+            used_ = 0;
+        }
+
+        std::size_t bytes_used() const noexcept {
+            return used_;
+        }
+
+    private:
+        struct Chunk {
+            Chunk* next;
+            std::size_t size;
+        };
+
+        static char* payload(Chunk* chunk) noexcept {
+            return reinterpret_cast<char*>(chunk) + sizeof(Chunk);
+        }
+
+        static void free_chunks(Chunk* chunk) noexcept {
+            while (chunk) {
+                Chunk* next = chunk->next;
+                ::operator delete(chunk);
+                chunk = next;
+            }
+        }
+
+        void* bump(std::size_t bytes, std::size_t align) noexcept {
+            if (!cur_) return nullptr;
+            auto addr = reinterpret_cast<std::uintptr_t>(cur_);
+            std::uintptr_t aligned = (addr + align - 1) & ~(static_cast<std::uintptr_t>(align) - 1);
+            std::size_t padding = aligned - addr;
+            if (padding > static_cast<std::size_t>(end_ - cur_) ||
+                bytes > static_cast<std::size_t>(end_ - cur_) - padding) {
+                return nullptr;
+            }
+            cur_ += padding + bytes;
+            used_ += bytes;
+            return reinterpret_cast<void*>(aligned);
+        }
+
+        void add_chunk(std::size_t min_payload) {
+            std::size_t size = std::max(next_chunk_size_, min_payload + sizeof(Chunk));
+            auto* chunk = static_cast<Chunk*>(::operator new(size));
+            chunk->next = chunks_;
+            chunk->size = size;
+            chunks_ = chunk;
+            cur_ = payload(chunk);
+            end_ = reinterpret_cast<char*>(chunk) + size;
+            next_chunk_size_ = size * 2;
+        }
+
+        Chunk* chunks_ = nullptr;
+        char* cur_ = nullptr;
+        char* end_ = nullptr;
+        std::size_t next_chunk_size_;
+        std::size_t used_ = 0;
+    };
+
+    template <typename T>
+    class ArenaAllocator {
+    public:
+        using value_type = T;
+        using propagate_on_container_copy_assignment = std::false_type;
+        using propagate_on_container_move_assignment = std::true_type;
+        using propagate_on_container_swap = std::true_type;
+        using is_always_equal = std::false_type;
+
+        ArenaAllocator(MonotonicArena& arena) noexcept : arena_(&arena) {}
+
+        template <typename U>
+        ArenaAllocator(const ArenaAllocator<U>& other) noexcept : arena_(other.arena()) {}
+
+        T* allocate(std::size_t n) {
+            if (n > static_cast<std::size_t>(-1) / sizeof(T)) throw std::bad_array_new_length();
+            return static_cast<T*>(arena_->allocate(n * sizeof(T), alignof(T)));
+        }
+
+        void deallocate(T*, std::size_t) noexcept {}
+
+        MonotonicArena* arena() const noexcept {
+            return arena_;
+        }
+
+        template <typename U>
+        bool operator==(const ArenaAllocator<U>& other) const noexcept {
+            return arena_ == other.arena();
+        }
+
+    private:
+        MonotonicArena* arena_;
+    };
+
+}  // namespace my_container
+
+#endif //ARENA_ARENA_HPP
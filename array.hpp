@@ -6,158 +6,197 @@
 #define FUNDS_4_1_CONTAINER_HPP
 
 #include <iostream>
+#include <algorithm>
+#include <iterator>
+#include <stdexcept>
+#include <type_traits>
 
-template <typename T, std::size_t N>
-class Container {
-public:
-    Container() = default;
-    Container(const Container& other) = default;
-    Container& operator=(const Container& other) = default;
-
-    virtual ~Container() = default;
-
-    virtual T* begin() = 0;
-    virtual const T* cbegin() const = 0;
-    virtual T* end() = 0;
-    virtual const T* cend() const = 0;
+#include "simd.hpp"
 
-    virtual bool operator==(const Container& other) const = 0;
-    virtual bool operator!=(const Container& other) const = 0;
-
-    virtual std::size_t size() const = 0;
-    virtual std::size_t max_size() const = 0;
-    virtual bool empty() const = 0;
-};
+// Fixed-size array. It is an aggregate with no virtual functions, so it is
+// a literal type laid out exactly like T[N]: it can be built in constant
+// expressions, brace-initialized like a C array and embedded in POD
+// structs. The SIMD kernels are used at run time only.
+//
+// Align raises the alignment of the storage, e.g. to a cache line so that
+// per-thread arrays never share one and the vector kernels start on a
+// boundary.
+template <typename T, std::size_t N, std::size_t Align = alignof(T)>
+struct Array {
+    static_assert(Align >= alignof(T) && (Align & (Align - 1)) == 0,
+                  "Array alignment must be a power of two no smaller than alignof(T)");
 
-template <typename T, std::size_t N>
-class Array final : public Container<T, N> {
-    T m_data[N];
+    alignas(Align) T m_data[N];
 
-public:
-    Array() = default;
-    Array(std::initializer_list<T> init) {
-        std::copy(init.begin(), init.end(), m_data);
-    }
-    ~Array() override = default;
-    Array(const Array& other) {
-        std::copy(other.cbegin(), other.cend(), this->begin());
-    }
-    Array(Array&& other) noexcept {
-        std::move(other.begin(), other.end(), this->begin());
-        std::fill(other.begin(),other.end(), T{});
-    }
-    Array& operator=(const Array& other) {
-        if (this != &other) {
-            std::copy(other.cbegin(), other.cend(), this->begin());
-        }
-        return *this;
-    }
-    Array& operator=(Array&& other) noexcept {
-        if (this != &other) {
-            std::move(other.begin(), other.end(), this->begin());
-        }
-        return *this;
-    }
-    T& at(std::size_t index) {
+    constexpr T& at(std::size_t index) {
         if (index >= N) {
             throw std::out_of_range("Index out of range");
         }
         return m_data[index];
     }
-    const T& at(std::size_t index) const {
+    constexpr const T& at(std::size_t index) const {
         if (index >= N) {
             throw std::out_of_range("Index out of range");
         }
         return m_data[index];
     }
-    T& operator[](std::size_t index) {
+    constexpr T& operator[](std::size_t index) {
         return m_data[index];
     }
-    const T& operator[](std::size_t index) const{
+    constexpr const T& operator[](std::size_t index) const{
         return m_data[index];
     }
-    T& front() {
+    constexpr T& front() {
         return m_data[0];
     }
-    const T& front() const{
+    constexpr const T& front() const{
         return m_data[0];
     }
-    T& back() {
+    constexpr T& back() {
         return m_data[N - 1];
     }
-    const T& back() const{
+    constexpr const T& back() const{
         return m_data[N - 1];
     }
-    T* data() noexcept {
+    constexpr T* data() noexcept {
+        return m_data;
+    }
+    constexpr const T* data() const noexcept {
         return m_data;
     }
-    const T* data() const noexcept {
+    constexpr T* begin() noexcept {
         return m_data;
     }
-    T* begin() noexcept override {
+    constexpr const T* begin() const noexcept {
         return m_data;
     }
-    const T* cbegin() const noexcept override {
+    constexpr const T* cbegin() const noexcept {
         return m_data;
     }
-    T* end() noexcept override {
+    constexpr T* end() noexcept {
         return m_data + N;
     }
-    const T* cend() const noexcept override {
+    constexpr const T* end() const noexcept {
         return m_data + N;
     }
-    std::reverse_iterator<T*> rbegin() noexcept {
+    constexpr const T* cend() const noexcept {
+        return m_data + N;
+    }
+    constexpr std::reverse_iterator<T*> rbegin() noexcept {
         return std::reverse_iterator<T*>(end());
     }
-    std::reverse_iterator<const T*> crbegin() const noexcept {
-        return std::reverse_iterator<T*>(cend());
+    constexpr std::reverse_iterator<const T*> crbegin() const noexcept {
+        return std::reverse_iterator<const T*>(cend());
     }
-    std::reverse_iterator<T*> rend() noexcept {
+    constexpr std::reverse_iterator<T*> rend() noexcept {
         return std::reverse_iterator<T*>(begin());
     }
-    std::reverse_iterator<const T*> crend() const noexcept {
-        return std::reverse_iterator<T*>(cbegin());
+    constexpr std::reverse_iterator<const T*> crend() const noexcept {
+        return std::reverse_iterator<const T*>(cbegin());
     }
-    std::size_t size() const noexcept override {
+    constexpr std::size_t size() const noexcept {
         return N;
     }
-    std::size_t max_size() const noexcept override {
+    constexpr std::size_t max_size() const noexcept {
         return N;
     }
-    bool empty() const noexcept override {
+    constexpr bool empty() const noexcept {
         return N == 0;
     }
-    void fill(const T& val) {
+    constexpr void fill(const T& val) {
+        if constexpr (my_container::simd::vectorizable<T>) {
+            if (!std::is_constant_evaluated()) return my_container::simd::fill(m_data, N, val);
+        }
         std::fill(begin(), end(), val);
     }
-    void swap(Array& other) noexcept {
+    // Same as copy assignment, but uses the SIMD kernel for arithmetic T.
+    constexpr void copy_from(const Array& other) {
+        if constexpr (my_container::simd::vectorizable<T>) {
+            if (!std::is_constant_evaluated()) {
+                if (this != &other) my_container::simd::copy(m_data, other.m_data, N);
+                return;
+            }
+        }
+        std::copy(other.cbegin(), other.cend(), begin());
+    }
+    constexpr void swap(Array& other) noexcept(std::is_nothrow_swappable_v<T>) {
+        if constexpr (my_container::simd::vectorizable<T>) {
+            if (!std::is_constant_evaluated()) {
+                if (this != &other) my_container::simd::swap_ranges(m_data, other.m_data, N);
+                return;
+            }
+        }
         std::swap_ranges(begin(), end(), other.begin());
     }
-    bool operator==(const Container<T, N>& other) const override {
-        const Array* otherArray = dynamic_cast<const Array*>(&other);
-        if (!otherArray) {
-            return false;
+    constexpr bool operator==(const Array& other) const {
+        if constexpr (my_container::simd::vectorizable<T>) {
+            if (!std::is_constant_evaluated()) return my_container::simd::equal(m_data, other.m_data, N);
         }
-        return std::equal(cbegin(), cend(), otherArray->cbegin(), otherArray->cend());
-    }
-    bool operator!=(const Container<T, N>& other) const override {
-        return !(*this == other);
+        return std::equal(cbegin(), cend(), other.cbegin(), other.cend());
     }
-    bool operator<(const Array& other) const {
+    constexpr bool operator<(const Array& other) const {
         return std::lexicographical_compare(cbegin(), cend(), other.cbegin(), other.cend());
     }
-    bool operator<=(const Array& other) const {
+    constexpr bool operator<=(const Array& other) const {
         return (*this == other) || (*this < other);
     }
-    bool operator>(const Array& other) const {
+    constexpr bool operator>(const Array& other) const {
         return other < *this;
     }
-    bool operator>=(const Array& other) const {
+    constexpr bool operator>=(const Array& other) const {
         return (other < *this) || (*this == other);
     }
-    auto operator<=>(const Array& other) const {
+    constexpr auto operator<=>(const Array& other) const {
+        if constexpr (my_container::simd::vectorizable<T>) {
+            if (!std::is_constant_evaluated()) return my_container::simd::compare_three_way(m_data, N, other.m_data, N);
+        }
         return std::lexicographical_compare_three_way(cbegin(), cend(), other.cbegin(), other.cend());
     }
+    constexpr std::size_t find(const T& value) const {
+        if constexpr (my_container::simd::vectorizable<T>) {
+            if (!std::is_constant_evaluated()) return my_container::simd::find(m_data, N, value);
+        }
+        return static_cast<std::size_t>(std::find(cbegin(), cend(), value) - cbegin());
+    }
+    constexpr std::size_t count(const T& value) const {
+        if constexpr (my_container::simd::vectorizable<T>) {
+            if (!std::is_constant_evaluated()) return my_container::simd::count(m_data, N, value);
+        }
+        return static_cast<std::size_t>(std::count(cbegin(), cend(), value));
+    }
+    constexpr T min() const {
+        if constexpr (my_container::simd::vectorizable<T>) {
+            if (!std::is_constant_evaluated()) return my_container::simd::min(m_data, N);
+        }
+        return *std::min_element(cbegin(), cend());
+    }
+    constexpr T max() const {
+        if constexpr (my_container::simd::vectorizable<T>) {
+            if (!std::is_constant_evaluated()) return my_container::simd::max(m_data, N);
+        }
+        return *std::max_element(cbegin(), cend());
+    }
+    constexpr T sum() const {
+        if constexpr (my_container::simd::vectorizable<T>) {
+            if (!std::is_constant_evaluated()) return my_container::simd::sum(m_data, N);
+        }
+        T result{};
+        for (const T& item : m_data) result = result + item;
+        return result;
+    }
 };
 
+template <typename T, std::size_t N, std::size_t Align>
+constexpr void swap(Array<T, N, Align>& a, Array<T, N, Align>& b) noexcept(std::is_nothrow_swappable_v<T>) {
+    a.swap(b);
+}
+
+// Array whose storage starts on its own 64-byte cache line and is padded to
+// a whole number of lines.
+template <typename T, std::size_t N>
+using CacheAlignedArray = Array<T, N, 64>;
+
+static_assert(std::is_aggregate_v<Array<int, 4>> && sizeof(Array<int, 4>) == sizeof(int[4]));
+static_assert(alignof(CacheAlignedArray<int, 4>) == 64);
+
 #endif //FUNDS_4_1_CONTAINER_HPP
@@ -0,0 +1,142 @@
+// Throughput of SpscQueue and MpmcQueue against a Deque guarded by a mutex.
+//
+//   g++ -std=c++20 -O2 -I.. concurrentqueuebench.cpp -pthread
+//   ./a.out [items per producer]
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <cstdio>
+#include <cstdlib>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+#include "../concurrentqueue.hpp"
+#include "../deque.hpp"
+
+namespace {
+
+    constexpr std::size_t queue_capacity = 1024;
+    constexpr std::size_t batch = 32;
+
+    // Bounded like the lock-free queues so that every variant applies the
+    // same back-pressure.
+    class LockedDeque {
+    public:
+        bool try_push(std::size_t value) {
+            std::lock_guard lock(mutex_);
+            if (items_.size() == queue_capacity) return false;
+            items_.push_back(value);
+            return true;
+        }
+
+        bool try_pop(std::size_t& out) {
+            std::lock_guard lock(mutex_);
+            if (items_.empty()) return false;
+            out = items_.front();
+            items_.pop_front();
+            return true;
+        }
+
+    private:
+        std::mutex mutex_;
+        Deque<std::size_t> items_;
+    };
+
+    // Runs producers and consumers that move items_per_producer values each
+    // and returns the number of values transferred per second.
+    template <typename Push, typename Pop>
+    double run(std::size_t producers, std::size_t consumers, std::size_t items_per_producer, Push push, Pop pop) {
+        const std::size_t total = producers * items_per_producer;
+        std::vector<std::size_t> sums(consumers);
+        std::vector<std::thread> threads;
+        std::atomic<std::size_t> consumed{0};
+        auto start = std::chrono::steady_clock::now();
+        for (std::size_t p = 0; p < producers; ++p) {
+            threads.emplace_back([&, p] {
+                for (std::size_t i = 0; i < items_per_producer;) {
+                    i += push(p * items_per_producer + i, items_per_producer - i);
+                    if (i < items_per_producer) std::this_thread::yield();
+                }
+            });
+        }
+        for (std::size_t c = 0; c < consumers; ++c) {
+            threads.emplace_back([&, c] {
+                while (consumed.load(std::memory_order_relaxed) < total) {
+                    std::size_t n = pop(sums[c]);
+                    if (n) consumed.fetch_add(n, std::memory_order_relaxed);
+                    else std::this_thread::yield();
+                }
+            });
+        }
+        for (std::thread& thread : threads) thread.join();
+        std::chrono::duration<double> elapsed = std::chrono::steady_clock::now() - start;
+
+        std::size_t sum = 0;
+        for (std::size_t s : sums) sum += s;
+        if (sum != total * (total - 1) / 2) {
+            std::fprintf(stderr, "lost or duplicated items\n");
+            std::exit(1);
+        }
+        return static_cast<double>(total) / elapsed.count();
+    }
+
+    // Pushes and pops one value per call, or up to batch values per call when
+    // bulk is set.
+    template <typename Queue>
+    double run_queue(Queue& queue, std::size_t producers, std::size_t consumers, std::size_t items, bool bulk) {
+        return run(
+                producers, consumers, items,
+                [&](std::size_t first, std::size_t left) -> std::size_t {
+                    if (!bulk) return queue.try_push(first) ? 1 : 0;
+                    std::size_t values[batch];
+                    std::size_t n = std::min(left, batch);
+                    for (std::size_t i = 0; i < n; ++i) values[i] = first + i;
+                    return queue.try_push_n(values, n);
+                },
+                [&](std::size_t& sum) -> std::size_t {
+                    std::size_t values[batch];
+                    std::size_t n = bulk ? queue.try_pop_n(values, batch) : queue.try_pop(values[0]);
+                    for (std::size_t i = 0; i < n; ++i) sum += values[i];
+                    return n;
+                });
+    }
+
+    void report(const char* name, std::size_t producers, std::size_t consumers, double rate) {
+        std::printf("%-22s %zuP/%zuC %12.0f items/s\n", name, producers, consumers, rate);
+    }
+
+}  // namespace
+
+int main(int argc, char** argv) {
+    std::size_t items = argc > 1 ? std::strtoull(argv[1], nullptr, 10) : 1000000;
+
+    {
+        my_container::SpscQueue<std::size_t> spsc(queue_capacity);
+        report("SpscQueue", 1, 1, run_queue(spsc, 1, 1, items, false));
+        report("SpscQueue bulk", 1, 1, run_queue(spsc, 1, 1, items, true));
+    }
+
+    const std::size_t shapes[][2] = {{1, 1}, {2, 2}, {4, 4}};
+    for (const auto& shape : shapes) {
+        std::size_t producers = shape[0];
+        std::size_t consumers = shape[1];
+        my_container::MpmcQueue<std::size_t> mpmc(queue_capacity);
+        report("MpmcQueue", producers, consumers, run_queue(mpmc, producers, consumers, items, false));
+        report("MpmcQueue bulk", producers, consumers, run_queue(mpmc, producers, consumers, items, true));
+
+        LockedDeque locked;
+        report("mutex + Deque", producers, consumers,
+               run(producers, consumers, items,
+                   [&](std::size_t first, std::size_t) -> std::size_t { return locked.try_push(first) ? 1 : 0; },
+                   [&](std::size_t& sum) -> std::size_t {
+                       std::size_t value;
+                       if (!locked.try_pop(value)) return 0;
+                       sum += value;
+                       return 1;
+                   }));
+    }
+    return 0;
+}
@@ -0,0 +1,94 @@
+// Contention benchmark for ConcurrentStack against a Stack guarded by a mutex.
+// Every thread pushes and pops in turn on one shared stack.
+//
+//   g++ -std=c++20 -O2 -I.. concurrentstackbench.cpp -pthread
+//   ./a.out [operations per thread]
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <cstdio>
+#include <cstdlib>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+#include "../concurrentstack.hpp"
+#include "../stack.hpp"
+
+namespace {
+
+    class LockedStack {
+    public:
+        void push(std::size_t value) {
+            std::lock_guard lock(mutex_);
+            items_.push(value);
+        }
+
+        bool try_pop(std::size_t& out) {
+            std::lock_guard lock(mutex_);
+            if (items_.empty()) return false;
+            out = items_.top();
+            items_.pop();
+            return true;
+        }
+
+    private:
+        std::mutex mutex_;
+        Stack<std::size_t> items_;
+    };
+
+    // Each thread pushes burst values and pops burst values, until it has
+    // done operations pushes. Returns pushes and pops per second.
+    template <typename S>
+    double run(S& stack, std::size_t threads, std::size_t operations, std::size_t burst) {
+        std::atomic<std::size_t> popped{0};
+        std::atomic<bool> go{false};
+        std::vector<std::thread> workers;
+        for (std::size_t t = 0; t < threads; ++t) {
+            workers.emplace_back([&, t] {
+                while (!go.load(std::memory_order_acquire)) std::this_thread::yield();
+                std::size_t local = 0;
+                std::size_t value;
+                for (std::size_t i = 0; i < operations; i += burst) {
+                    std::size_t n = std::min(burst, operations - i);
+                    for (std::size_t j = 0; j < n; ++j) stack.push(t * operations + i + j);
+                    for (std::size_t j = 0; j < n; ++j) local += stack.try_pop(value) ? 1 : 0;
+                }
+                popped.fetch_add(local, std::memory_order_relaxed);
+            });
+        }
+        auto start = std::chrono::steady_clock::now();
+        go.store(true, std::memory_order_release);
+        for (std::thread& worker : workers) worker.join();
+        std::chrono::duration<double> elapsed = std::chrono::steady_clock::now() - start;
+
+        std::size_t value;
+        std::size_t left = 0;
+        while (stack.try_pop(value)) ++left;
+        if (popped.load() + left != threads * operations) {
+            std::fprintf(stderr, "lost or duplicated items\n");
+            std::exit(1);
+        }
+        return static_cast<double>(2 * threads * operations) / elapsed.count();
+    }
+
+}  // namespace
+
+int main(int argc, char** argv) {
+    std::size_t operations = argc > 1 ? std::strtoull(argv[1], nullptr, 10) : 1000000;
+    std::size_t hardware = std::max(1u, std::thread::hardware_concurrency());
+
+    for (std::size_t burst : {1, 16}) {
+        for (std::size_t threads = 1; threads <= 2 * hardware; threads *= 2) {
+            my_container::ConcurrentStack<std::size_t> lock_free;
+            LockedStack locked;
+            double a = run(lock_free, threads, operations, burst);
+            double b = run(locked, threads, operations, burst);
+            std::printf("burst %2zu, %2zu threads: ConcurrentStack %12.0f ops/s, mutex + Stack %12.0f ops/s\n", burst,
+                        threads, a, b);
+        }
+    }
+    return 0;
+}
@@ -0,0 +1,331 @@
+#ifndef CONCURRENTQUEUE_CONCURRENTQUEUE_HPP
+#define CONCURRENTQUEUE_CONCURRENTQUEUE_HPP
+
+#include <atomic>
+#include <bit>
+#include <cstddef>
+#include <iterator>
+#include <memory>
+#include <new>
+#include <stdexcept>
+#include <type_traits>
+#include <utility>
+
+#include "threadpool.hpp"
+
+namespace my_container {
+
+    // Wait-free bounded queue for exactly one producer thread and one consumer
+    // thread. The capacity is rounded up to a power of two. Each side keeps a
+    // cached copy of the other side's index and only reloads it when the
+    // queue looks full (or empty), so the shared lines are touched rarely.
+    template <typename T>
+    class SpscQueue {
+    public:
+        explicit SpscQueue(std::size_t capacity)
+                : capacity_(std::bit_ceil(std::max<std::size_t>(capacity, 2))),
+                  mask_(capacity_ - 1),
+                  slots_(std::allocator<T>().allocate(capacity_)) {}
+
+        SpscQueue(const SpscQueue&) = delete;
+        SpscQueue& operator=(const SpscQueue&) = delete;
+
+        ~SpscQueue() {
+            std::size_t head = head_.value.load(std::memory_order_relaxed);
+            std::size_t tail = tail_.value.load(std::memory_order_relaxed);
+            for (; head != tail; ++head) std::destroy_at(slots_ + (head & mask_));
+            std::allocator<T>().deallocate(slots_, capacity_);
+        }
+
+        std::size_t capacity() const noexcept {
+            return capacity_;
+        }
+
+        // Approximate when called while the other side is running.
+        std::size_t size() const noexcept {
+            return tail_.value.load(std::memory_order_acquire) - head_.value.load(std::memory_order_acquire);
+        }
+
+        bool empty() const noexcept {
+            return size() == 0;
+        }
+
+        // Producer side.
+        template <typename... Args>
+        bool try_emplace(Args&&... args) {
+            std::size_t tail = tail_.value.load(std::memory_order_relaxed);
+            if (tail - producer_.head_cache == capacity_) {
+                producer_.head_cache = head_.value.load(std::memory_order_acquire);
+                if (tail - producer_.head_cache == capacity_) return false;
+            }
+            ::new (static_cast<void*>(slots_ + (tail & mask_))) T(std::forward<Args>(args)...);
+            tail_.value.store(tail + 1, std::memory_order_release);
+            return true;
+        }
+
+        bool try_push(const T& value) {
+            return try_emplace(value);
+        }
+
+        bool try_push(T&& value) {
+            return try_emplace(std::move(value));
+        }
+
+        // Copies up to count elements from first and publishes them at once.
+        // Returns how many were pushed.
+        template <typename InputIt>
+        std::size_t try_push_n(InputIt first, std::size_t count) {
+            std::size_t tail = tail_.value.load(std::memory_order_relaxed);
+            std::size_t room = capacity_ - (tail - producer_.head_cache);
+            if (room < count) {
+                producer_.head_cache = head_.value.load(std::memory_order_acquire);
+                room = capacity_ - (tail - producer_.head_cache);
+            }
+            std::size_t n = std::min(room, count);
+            std::size_t done = 0;
+            try {
+                for (; done < n; ++done, ++first) {
+                    ::new (static_cast<void*>(slots_ + ((tail + done) & mask_))) T(*first);
+                }
+            } catch (...) {
+                tail_.value.store(tail + done, std::memory_order_release);
+                throw;
+            }
+            tail_.value.store(tail + n, std::memory_order_release);
+            return n;
+        }
+
+        // Consumer side.
+        bool try_pop(T& out) {
+            std::size_t head = head_.value.load(std::memory_order_relaxed);
+            if (head == consumer_.tail_cache) {
+                consumer_.tail_cache = tail_.value.load(std::memory_order_acquire);
+                if (head == consumer_.tail_cache) return false;
+            }
+            T* slot = slots_ + (head & mask_);
+            out = std::move(*slot);
+            std::destroy_at(slot);
+            head_.value.store(head + 1, std::memory_order_release);
+            return true;
+        }
+
+        // Moves up to max_count elements to out and releases their slots at
+        // once. Returns how many were popped.
+        template <typename OutputIt>
+        std::size_t try_pop_n(OutputIt out, std::size_t max_count) {
+            std::size_t head = head_.value.load(std::memory_order_relaxed);
+            std::size_t ready = consumer_.tail_cache - head;
+            if (ready < max_count) {
+                consumer_.tail_cache = tail_.value.load(std::memory_order_acquire);
+                ready = consumer_.tail_cache - head;
+            }
+            std::size_t n = std::min(ready, max_count);
+            std::size_t done = 0;
+            try {
+                for (; done < n; ++done, ++out) {
+                    T* slot = slots_ + ((head + done) & mask_);
+                    *out = std::move(*slot);
+                    std::destroy_at(slot);
+                }
+            } catch (...) {
+                // The element whose assignment threw stays in the queue.
+                head_.value.store(head + done, std::memory_order_release);
+                throw;
+            }
+            head_.value.store(head + n, std::memory_order_release);
+            return n;
+        }
+
+    private:
+        struct alignas(cache_line_size) Index {
+            std::atomic<std::size_t> value{0};
+        };
+
+        struct alignas(cache_line_size) ProducerState {
+            std::size_t head_cache = 0;
+        };
+
+        struct alignas(cache_line_size) ConsumerState {
+            std::size_t tail_cache = 0;
+        };
+
+        const std::size_t capacity_;
+        const std::size_t mask_;
+        T* const slots_;
+        Index head_;
+        Index tail_;
+        ProducerState producer_;
+        ConsumerState consumer_;
+    };
+
+    // Lock-free bounded queue for any number of producers and consumers
+    // (D. Vyukov's design). Every cell carries a sequence number that says
+    // whether it is ready for the producer or the consumer of a given lap,
+    // so producers and consumers only contend on their own index. A claimed
+    // cell must always be released, so values are built before a cell is
+    // claimed and moved in and out of it, which requires a non-throwing move.
+    // A popped element has left its cell before it is assigned to the
+    // caller, so try_pop requires a non-throwing move assignment; see
+    // try_pop_n for output iterators that may throw.
+    template <typename T>
+    class MpmcQueue {
+        static_assert(std::is_nothrow_move_constructible_v<T>, "MpmcQueue moves elements in and out of cells");
+
+    public:
+        explicit MpmcQueue(std::size_t capacity)
+                : capacity_(std::bit_ceil(std::max<std::size_t>(capacity, 2))),
+                  mask_(capacity_ - 1),
+                  cells_(std::make_unique<Cell[]>(capacity_)) {
+            for (std::size_t i = 0; i < capacity_; ++i) cells_[i].sequence.store(i, std::memory_order_relaxed);
+        }
+
+        MpmcQueue(const MpmcQueue&) = delete;
+        MpmcQueue& operator=(const MpmcQueue&) = delete;
+
+        ~MpmcQueue() {
+            std::size_t head = dequeue_.value.load(std::memory_order_relaxed);
+            std::size_t tail = enqueue_.value.load(std::memory_order_relaxed);
+            for (; head != tail; ++head) std::destroy_at(cells_[head & mask_].value());
+        }
+
+        std::size_t capacity() const noexcept {
+            return capacity_;
+        }
+
+        template <typename... Args>
+        bool try_emplace(Args&&... args) {
+            if constexpr (std::is_nothrow_constructible_v<T, Args&&...>) {
+                return try_claim_and_publish(std::forward<Args>(args)...);
+            } else {
+                T value(std::forward<Args>(args)...);
+                return try_claim_and_publish(std::move(value));
+            }
+        }
+
+        bool try_push(const T& value) {
+            return try_emplace(value);
+        }
+
+        bool try_push(T&& value) {
+            return try_emplace(std::move(value));
+        }
+
+        bool try_pop(T& out) {
+            static_assert(std::is_nothrow_move_assignable_v<T>, "try_pop moves the element out of a released cell");
+            std::size_t pos;
+            if (!claim(dequeue_, 1, 1, pos)) return false;
+            out = take(&cells_[pos & mask_], pos);
+            return true;
+        }
+
+        // Claims up to count consecutive free cells with a single CAS and
+        // fills them from first. Elements whose construction may throw are
+        // pushed one at a time instead. Returns how many were pushed.
+        template <typename InputIt>
+        std::size_t try_push_n(InputIt first, std::size_t count) {
+            if constexpr (!std::is_nothrow_constructible_v<T, std::iter_reference_t<InputIt>>) {
+                std::size_t n = 0;
+                for (; n < count && try_emplace(*first); ++n, ++first) {}
+                return n;
+            } else {
+                std::size_t pos;
+                std::size_t n = claim(enqueue_, 0, count, pos);
+                for (std::size_t i = 0; i < n; ++i, ++first) publish(&cells_[(pos + i) & mask_], pos + i, *first);
+                return n;
+            }
+        }
+
+        // Claims up to max_count consecutive filled cells with a single CAS
+        // and moves them to out. When assigning to out may throw, elements are
+        // popped one at a time instead, so that no claimed cell is left
+        // behind; the element whose assignment throws is then lost, since its
+        // cell has already been handed on. Returns how many were popped.
+        template <typename OutputIt>
+        std::size_t try_pop_n(OutputIt out, std::size_t max_count) {
+            std::size_t pos;
+            if constexpr (!std::is_nothrow_assignable_v<std::iter_reference_t<OutputIt>, T&&>) {
+                std::size_t n = 0;
+                for (; n < max_count && claim(dequeue_, 1, 1, pos); ++n, ++out) {
+                    *out = take(&cells_[pos & mask_], pos);
+                }
+                return n;
+            } else {
+                std::size_t n = claim(dequeue_, 1, max_count, pos);
+                for (std::size_t i = 0; i < n; ++i, ++out) *out = take(&cells_[(pos + i) & mask_], pos + i);
+                return n;
+            }
+        }
+
+    private:
+        struct Cell {
+            std::atomic<std::size_t> sequence;
+            alignas(T) unsigned char storage[sizeof(T)];
+
+            T* value() noexcept {
+                return std::launder(reinterpret_cast<T*>(storage));
+            }
+        };
+
+        struct alignas(cache_line_size) Index {
+            std::atomic<std::size_t> value{0};
+        };
+
+        // Claims up to max_count consecutive cells through index, starting at
+        // pos on return. A cell is ready when its sequence equals its position
+        // plus lag (0 for producers, 1 for consumers). A sequence behind that
+        // means the queue is full (or empty); one ahead means another thread
+        // took the cell since index was loaded, so index is reloaded.
+        // Returns how many cells were claimed.
+        std::size_t claim(Index& index, std::size_t lag, std::size_t max_count, std::size_t& pos) noexcept {
+            if (max_count == 0) return 0;
+            pos = index.value.load(std::memory_order_relaxed);
+            for (;;) {
+                std::size_t seq = cells_[pos & mask_].sequence.load(std::memory_order_acquire);
+                auto diff = static_cast<std::ptrdiff_t>(seq - (pos + lag));
+                if (diff < 0) return 0;
+                if (diff > 0) {
+                    pos = index.value.load(std::memory_order_relaxed);
+                    continue;
+                }
+                std::size_t n = 1;
+                while (n < max_count && n < capacity_ &&
+                       cells_[(pos + n) & mask_].sequence.load(std::memory_order_acquire) == pos + n + lag) {
+                    ++n;
+                }
+                if (index.value.compare_exchange_weak(pos, pos + n, std::memory_order_relaxed)) return n;
+            }
+        }
+
+        template <typename... Args>
+        bool try_claim_and_publish(Args&&... args) noexcept {
+            std::size_t pos;
+            if (!claim(enqueue_, 0, 1, pos)) return false;
+            publish(&cells_[pos & mask_], pos, std::forward<Args>(args)...);
+            return true;
+        }
+
+        template <typename... Args>
+        void publish(Cell* cell, std::size_t pos, Args&&... args) noexcept {
+            ::new (static_cast<void*>(cell->storage)) T(std::forward<Args>(args)...);
+            cell->sequence.store(pos + 1, std::memory_order_release);
+        }
+
+        // Moves the value out and hands the cell to the producers of the next
+        // lap before the caller's assignment can throw.
+        T take(Cell* cell, std::size_t pos) noexcept {
+            T value(std::move(*cell->value()));
+            std::destroy_at(cell->value());
+            cell->sequence.store(pos + capacity_, std::memory_order_release);
+            return value;
+        }
+
+        const std::size_t capacity_;
+        const std::size_t mask_;
+        std::unique_ptr<Cell[]> cells_;
+        Index enqueue_;
+        Index dequeue_;
+    };
+
+}  // namespace my_container
+
+#endif //CONCURRENTQUEUE_CONCURRENTQUEUE_HPP
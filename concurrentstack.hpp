@@ -0,0 +1,141 @@
+#ifndef CONCURRENTSTACK_CONCURRENTSTACK_HPP
+#define CONCURRENTSTACK_CONCURRENTSTACK_HPP
+
+#include <atomic>
+#include <cstddef>
+#include <iterator>
+#include <ranges>
+#include <thread>
+#include <type_traits>
+#include <utility>
+
+#include "hazardpointer.hpp"
+
+namespace my_container {
+
+    // Lock-free LIFO stack (R. K. Treiber) for any number of threads. Nodes
+    // unlinked by try_pop() and pop_all() are retired through hazard
+    // pointers, so a concurrent try_pop() never reads a freed node and its
+    // CAS on the head cannot succeed against a recycled address.
+    template <typename T>
+    class ConcurrentStack {
+    public:
+        ConcurrentStack() = default;
+
+        ConcurrentStack(const ConcurrentStack&) = delete;
+        ConcurrentStack& operator=(const ConcurrentStack&) = delete;
+
+        // Must not race with other operations.
+        ~ConcurrentStack() {
+            Node* node = head_.load(std::memory_order_relaxed);
+            while (node) delete std::exchange(node, node->next);
+        }
+
+        // Approximate when other threads are running.
+        bool empty() const noexcept {
+            return head_.load(std::memory_order_acquire) == nullptr;
+        }
+
+        template <typename... Args>
+        void emplace(Args&&... args) {
+            Node* node = new Node(std::forward<Args>(args)...);
+            link(node, node);
+        }
+
+        void push(const T& value) {
+            emplace(value);
+        }
+
+        void push(T&& value) {
+            emplace(std::move(value));
+        }
+
+        // Builds a private chain from range and publishes it with a single
+        // CAS, so the last element of range ends up on top.
+        template <std::ranges::input_range R>
+        void push_chain(R&& range) {
+            Node* first = nullptr;
+            Node* last = nullptr;
+            try {
+                for (auto&& item : range) {
+                    Node* node = new Node(std::forward<decltype(item)>(item));
+                    node->next = first;
+                    first = node;
+                    if (!last) last = node;
+                }
+            } catch (...) {
+                while (first) delete std::exchange(first, first->next);
+                throw;
+            }
+            if (first) link(first, last);
+        }
+
+        // The node cannot be linked again once it is unlinked, since another
+        // thread may still hold it in a failed CAS, so the element would be
+        // lost if moving it out threw.
+        bool try_pop(T& out) {
+            static_assert(std::is_nothrow_move_assignable_v<T>, "try_pop moves the element out of an unlinked node");
+            HazardPointer hazard;
+            Node* node;
+            do {
+                node = hazard.protect(head_);
+                if (!node) return false;
+            } while (!head_.compare_exchange_weak(node, node->next, std::memory_order_acquire,
+                                                  std::memory_order_relaxed));
+            hazard.reset();
+            out = std::move(node->value);
+            hazard_retire(node);
+            return true;
+        }
+
+        // Detaches the whole stack with one exchange and moves its elements to
+        // out, top first. Returns how many were popped. If assigning to out
+        // throws, the elements not yet popped are pushed back in order.
+        template <typename OutputIt>
+        std::size_t pop_all(OutputIt out) {
+            Node* node = head_.exchange(nullptr, std::memory_order_acquire);
+            std::size_t count = 0;
+            try {
+                for (; node; ++out, ++count) {
+                    *out = std::move(node->value);
+                    hazard_retire(std::exchange(node, node->next));
+                }
+            } catch (...) {
+                // node and the ones after it still hold their elements, so
+                // they go back on the stack. Linking them sets the last one's
+                // next, which a try_pop that protected it before the exchange
+                // still expects to be null, so wait until that try_pop has
+                // moved on before the node is reused.
+                if (node) {
+                    Node* last = node;
+                    while (last->next) last = last->next;
+                    while (HazardDomain::global().is_protected(last)) std::this_thread::yield();
+                    link(node, last);
+                }
+                throw;
+            }
+            return count;
+        }
+
+    private:
+        struct Node {
+            template <typename... Args>
+            explicit Node(Args&&... args): value(std::forward<Args>(args)...) {}
+
+            T value;
+            Node* next = nullptr;
+        };
+
+        void link(Node* first, Node* last) noexcept {
+            Node* head = head_.load(std::memory_order_relaxed);
+            do {
+                last->next = head;
+            } while (!head_.compare_exchange_weak(head, first, std::memory_order_release, std::memory_order_relaxed));
+        }
+
+        alignas(cache_line_size) std::atomic<Node*> head_{nullptr};
+    };
+
+}  // namespace my_container
+
+#endif //CONCURRENTSTACK_CONCURRENTSTACK_HPP
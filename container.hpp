@@ -0,0 +1,25 @@
+#ifndef CONTAINER_CONTAINER_HPP
+#define CONTAINER_CONTAINER_HPP
+
+#include <cstddef>
+
+template <typename T>
+class Container {
+public:
+    Container() = default;
+    Container(const Container& other) = default;
+    virtual Container& operator=(const Container& other) = 0;
+    virtual ~Container() = 0;
+
+    virtual bool operator==(const Container& other) const = 0;
+    virtual bool operator!=(const Container& other) const = 0;
+
+    virtual std::size_t size() const = 0;
+    virtual std::size_t max_size() const = 0;
+    virtual bool empty() const = 0;
+};
+
+template <typename T>
+Container<T>:: ~Container() = default;
+
+#endif //CONTAINER_CONTAINER_HPP
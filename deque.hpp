@@ -5,77 +5,732 @@
 #ifndef DEQUE_DEQUE_HPP
 #define DEQUE_DEQUE_HPP
 
-#include "list.hpp"
+#include <algorithm>
+#include <bit>
+#include <compare>
+#include <cstring>
+#include <functional>
+#include <initializer_list>
+#include <iterator>
+#include <limits>
+#include <memory>
+#include <stdexcept>
+#include <type_traits>
+#include <utility>
 
+#include "container.hpp"
+#include "nodepool.hpp"
+
+// Elements are kept in fixed-size blocks of block_size elements (a power of
+// two, about 4 KiB per block) reached through a map of block pointers. The
+// map is indexed by (start + i) / block_size, so indexing is constant time and
+// pushing at either end never moves existing elements.
+//
+// Blocks come from std::allocator unless the deque is given a node_pool, in
+// which case deques sharing the pool recycle each other's blocks.
 template <typename T>
-class Deque : public List<T> {
+class Deque : public Container<T> {
+public:
+    static constexpr std::size_t block_size =
+            std::bit_floor(std::max<std::size_t>(4096 / sizeof(T), 16));
+
+private:
+    static constexpr std::size_t block_shift = std::countr_zero(block_size);
+    static constexpr std::size_t block_mask = block_size - 1;
+
+    struct Block {
+        alignas(T) unsigned char bytes[block_size * sizeof(T)];
+    };
+
+    // Segmented iterator: a pointer into the current block plus the map
+    // slot of that block, so that stepping within a block is a pointer
+    // increment and jumps of any length are constant time.
+    template <bool Const>
+    class basic_iterator {
+        friend class Deque;
+        friend class basic_iterator<!Const>;
+
+    public:
+        using iterator_category = std::random_access_iterator_tag;
+        using iterator_concept = std::random_access_iterator_tag;
+        using value_type = T;
+        using difference_type = std::ptrdiff_t;
+        using pointer = std::conditional_t<Const, const T*, T*>;
+        using reference = std::conditional_t<Const, const T&, T&>;
+
+        basic_iterator() : cur(nullptr), first(nullptr), node(nullptr) {}
+
+        template <bool C = Const, typename = std::enable_if_t<C>>
+        basic_iterator(const basic_iterator<false> &it) : cur(it.cur), first(it.first), node(it.node) {}
+
+        reference operator*() const { return *cur; }
+        pointer operator->() const { return cur; }
+        reference operator[](difference_type n) const { return *(*this + n); }
+
+        basic_iterator &operator++() {
+            if (++cur == first + block_size) {
+                set_node(node + 1);
+                cur = first;
+            }
+            return *this;
+        }
+
+        basic_iterator operator++(int) {
+            basic_iterator tmp = *this;
+            ++(*this);
+            return tmp;
+        }
+
+        basic_iterator &operator--() {
+            if (cur == first) {
+                set_node(node - 1);
+                cur = first + block_size;
+            }
+            --cur;
+            return *this;
+        }
+
+        basic_iterator operator--(int) {
+            basic_iterator tmp = *this;
+            --(*this);
+            return tmp;
+        }
+
+        basic_iterator &operator+=(difference_type n) {
+            constexpr auto block = static_cast<difference_type>(block_size);
+            difference_type offset = n + (cur - first);
+            if (offset >= 0 && offset < block) {
+                cur += n;
+            } else {
+                difference_type blocks = offset >= 0 ? offset / block : -((-offset - 1) / block) - 1;
+                set_node(node + blocks);
+                cur = first + (offset - blocks * block);
+            }
+            return *this;
+        }
+
+        basic_iterator &operator-=(difference_type n) { return *this += -n; }
+
+        friend basic_iterator operator+(basic_iterator it, difference_type n) { return it += n; }
+        friend basic_iterator operator+(difference_type n, basic_iterator it) { return it += n; }
+        friend basic_iterator operator-(basic_iterator it, difference_type n) { return it -= n; }
+
+        friend difference_type operator-(const basic_iterator &a, const basic_iterator &b) {
+            return (a.node - b.node) * static_cast<difference_type>(block_size) + (a.cur - a.first) - (b.cur - b.first);
+        }
+
+        friend bool operator==(const basic_iterator &a, const basic_iterator &b) {
+            return a.cur == b.cur && a.node == b.node;
+        }
+
+        friend std::strong_ordering operator<=>(const basic_iterator &a, const basic_iterator &b) {
+            if (auto cmp = a.node <=> b.node; cmp != 0) return cmp;
+            return a.cur <=> b.cur;
+        }
+
+    private:
+        void set_node(T *const *n) {
+            node = n;
+            first = *n;
+        }
+
+        pointer cur;
+        pointer first;
+        T *const *node;
+    };
+
 public:
+    using iterator = basic_iterator<false>;
+    using const_iterator = basic_iterator<true>;
+    using reverse_iterator = std::reverse_iterator<iterator>;
+    using const_reverse_iterator = std::reverse_iterator<const_iterator>;
+    using node_pool = NodePool<Block>;
+
     Deque() = default;
 
+    // Deques constructed with the same pool share its slabs and free list.
+    explicit Deque(std::shared_ptr<node_pool> pool) : pool(std::move(pool)) {}
+
     Deque(const Deque<T> &other);
 
     Deque(Deque<T> &&other) noexcept;
 
-    Deque(std::initializer_list<T> init) : List<T>(init) {}
+    Deque(std::initializer_list<T> init);
+
+    ~Deque() override;
+
+    Container<T>& operator=(const Container<T>& other) override;
 
     Deque<T> &operator=(const Deque &other);
 
     Deque<T> &operator=(Deque<T> &&other) noexcept;
 
     T &at(size_t pos);
+    const T &at(size_t pos) const;
+
+    T &operator[](size_t pos) { return slot(start + pos); }
+    const T &operator[](size_t pos) const { return slot(start + pos); }
+
+    T &front();
+    const T &front() const;
+    T &back();
+    const T &back() const;
+
+    iterator begin() noexcept { return iterator_at<iterator>(start); }
+    iterator end() noexcept { return iterator_at<iterator>(start + count); }
+    const_iterator begin() const noexcept { return iterator_at<const_iterator>(start); }
+    const_iterator end() const noexcept { return iterator_at<const_iterator>(start + count); }
+    const_iterator cbegin() const noexcept { return begin(); }
+    const_iterator cend() const noexcept { return end(); }
+
+    reverse_iterator rbegin() noexcept { return reverse_iterator(end()); }
+    reverse_iterator rend() noexcept { return reverse_iterator(begin()); }
+    const_reverse_iterator rbegin() const noexcept { return const_reverse_iterator(end()); }
+    const_reverse_iterator rend() const noexcept { return const_reverse_iterator(begin()); }
+    const_reverse_iterator crbegin() const noexcept { return rbegin(); }
+    const_reverse_iterator crend() const noexcept { return rend(); }
+
+    bool empty() const noexcept override { return count == 0; }
+    std::size_t size() const noexcept override { return count; }
+    std::size_t max_size() const noexcept override { return std::numeric_limits<std::size_t>::max() / sizeof(T); }
+
+    template <typename... Args>
+    T &emplace_back(Args &&...args);
+
+    template <typename... Args>
+    T &emplace_front(Args &&...args);
+
+    void push_back(const T &value) { emplace_back(value); }
+    void push_back(T &&value) { emplace_back(std::move(value)); }
+    void push_front(const T &value) { emplace_front(value); }
+    void push_front(T &&value) { emplace_front(std::move(value)); }
+
+    void pop_back();
+    void pop_front();
 
-    T &operator[](size_t pos);
+    template <typename... Args>
+    iterator emplace(const_iterator pos, Args &&...args);
+
+    iterator insert(const_iterator pos, const T &value) { return emplace(pos, value); }
+    iterator insert(const_iterator pos, T &&value) { return emplace(pos, std::move(value)); }
+
+    iterator erase(const_iterator pos) { return erase(pos, pos + 1); }
+    iterator erase(const_iterator first, const_iterator last);
+
+    // Pointer-based modifiers find the block holding pos by walking the map.
+    // A null pos inserts at the front, one past the last element at the back.
+    // Both return nullptr when pos is not an element of this deque; erase
+    // also returns nullptr after removing the last element.
+    T *insert(const T *pos, const T &value);
+    T *erase(const T *pos);
+
+    // Splicing moves the values into this deque; elements in between are
+    // shifted, so iterators and references into either deque are invalidated.
+    void splice(const_iterator pos, Deque &other);
+    void splice(const_iterator pos, Deque &&other) { splice(pos, other); }
+    void splice(const_iterator pos, Deque &other, const_iterator it);
+    void splice_range(const_iterator pos, Deque &other, const_iterator first, const_iterator last);
+
+    // Merges the sorted deque other into this sorted deque. Equal elements
+    // from this deque come first.
+    template <typename Compare>
+    void merge(Deque &other, Compare comp);
+    template <typename Compare>
+    void merge(Deque &&other, Compare comp) { merge(other, comp); }
+    void merge(Deque &other) { merge(other, std::less<>()); }
+    void merge(Deque &&other) { merge(other, std::less<>()); }
+
+    // Stable sort.
+    template <typename Compare>
+    void sort(Compare comp) { std::stable_sort(begin(), end(), comp); }
+    void sort() { sort(std::less<>()); }
+
+    // Removes consecutive elements for which pred holds; returns how many were
+    // removed.
+    template <typename BinaryPredicate>
+    std::size_t unique(BinaryPredicate pred);
+    std::size_t unique() { return unique(std::equal_to<>()); }
+
+    void reverse() noexcept(std::is_nothrow_swappable_v<T>) { std::reverse(begin(), end()); }
+
+    void resize(std::size_t new_size, const T &value = T());
+    void clear() noexcept;
+    void shrink_to_fit() noexcept;
+    void swap(Deque &other) noexcept;
+
+    bool operator==(const Deque &other) const;
+    std::strong_ordering operator<=>(const Deque &other) const;
 
     bool operator==(const Container<T>& other) const override;
     bool operator!=(const Container<T>& other) const override;
 
+private:
+    T **map = nullptr;
+    std::size_t map_capacity = 0;
+    // Position of the first element in the slot space spanned by the map.
+    std::size_t start = 0;
+    std::size_t count = 0;
+    // One emptied block is kept so that pushing and popping across a block
+    // boundary does not allocate every time.
+    T *spare = nullptr;
+    std::shared_ptr<node_pool> pool;
+
+    T &slot(std::size_t pos) { return map[pos >> block_shift][pos & block_mask]; }
+
+    // The map has one extra null slot past map_capacity so that an iterator
+    // can step onto the block after the last one.
+    template <typename It>
+    It iterator_at(std::size_t pos) const noexcept {
+        It it;
+        if (!map) return it;
+        it.set_node(map + (pos >> block_shift));
+        it.cur = it.first ? it.first + (pos & block_mask) : nullptr;
+        return it;
+    }
+    const T &slot(std::size_t pos) const { return map[pos >> block_shift][pos & block_mask]; }
+
+    bool locate(const T *pos, std::size_t &index) const noexcept;
+    template <typename It>
+    void insert_at(std::size_t index, It first, It last);
+
+    T *take_block();
+    void free_block(T *block) noexcept;
+    void release_block(std::size_t block) noexcept;
+    void recenter_map();
+    void destroy_all() noexcept;
+    void free_storage() noexcept;
 };
 
-template<typename T>
-bool Deque<T>::operator==(const Container<T>& other) const {
-    const Deque<T>* otherDeque = dynamic_cast<const Deque<T>*>(&other);
-    if (!otherDeque) return false;
-    return static_cast<const List<T>&>(*this) == static_cast<const List<T>&>(*otherDeque);
+template <typename T>
+Deque<T>::Deque(const Deque &other) : Container<T>() {
+    try {
+        for (const T &item : other) push_back(item);
+    } catch (...) {
+        free_storage();
+        throw;
+    }
 }
 
-template<typename T>
-bool Deque<T>::operator!=(const Container<T>& other) const {
-    return !(*this == other);
+template <typename T>
+Deque<T>::Deque(Deque &&other) noexcept
+        : map(std::exchange(other.map, nullptr)), map_capacity(std::exchange(other.map_capacity, 0)),
+          start(std::exchange(other.start, 0)), count(std::exchange(other.count, 0)),
+          spare(std::exchange(other.spare, nullptr)), pool(std::move(other.pool)) {}
+
+template <typename T>
+Deque<T>::Deque(std::initializer_list<T> init) {
+    try {
+        for (const T &item : init) push_back(item);
+    } catch (...) {
+        free_storage();
+        throw;
+    }
+}
+
+template <typename T>
+Deque<T>::~Deque() {
+    free_storage();
+}
+
+template <typename T>
+Container<T> &Deque<T>::operator=(const Container<T> &other) {
+    if (this != &other) {
+        auto *deque = dynamic_cast<const Deque *>(&other);
+        if (!deque) {
+            throw std::invalid_argument("Assigned Container must be of type Deque");
+        }
+        *this = *deque;
+    }
+    return *this;
 }
 
 template<typename T>
 Deque<T> &Deque<T>::operator=(Deque &&other) noexcept {
-    List<T>::operator=(std::move(other));
+    if (this != &other) {
+        Deque tmp(std::move(other));
+        swap(tmp);
+    }
     return *this;
 }
 
+// Keeps the target's pool.
 template<typename T>
 Deque<T> &Deque<T>::operator=(const Deque &other) {
-    List<T>::operator=(other);
+    if (this != &other) {
+        Deque tmp(pool);
+        for (const T &item : other) tmp.push_back(item);
+        swap(tmp);
+    }
     return *this;
 }
 
 template<typename T>
-Deque<T>::Deque(Deque &&other) noexcept : List<T>(std::move(other)) {}
+bool Deque<T>::operator==(const Container<T>& other) const {
+    const Deque<T>* otherDeque = dynamic_cast<const Deque<T>*>(&other);
+    if (!otherDeque) return false;
+    return *this == *otherDeque;
+}
 
 template<typename T>
-Deque<T>::Deque(const Deque &other) : List<T>(other) {}
+bool Deque<T>::operator!=(const Container<T>& other) const {
+    return !(*this == other);
+}
 
+template <typename T>
+bool Deque<T>::operator==(const Deque &other) const {
+    return count == other.count && std::equal(begin(), end(), other.begin());
+}
 
 template <typename T>
-T &Deque<T>::operator[](size_t pos) {
-    auto it = this->begin();
-    std::advance(it, pos);
-    return *it;
+std::strong_ordering Deque<T>::operator<=>(const Deque &other) const {
+    std::size_t n = std::min(count, other.count);
+    for (std::size_t i = 0; i < n; ++i) {
+        if (auto cmp = (*this)[i] <=> other[i]; cmp != 0) return cmp;
+    }
+    return count <=> other.count;
 }
 
 template <typename T>
 T &Deque<T>::at(size_t pos) {
-    if (pos >= this->size()) {
+    if (pos >= count) {
         throw std::out_of_range("At");
     }
     return (*this)[pos];
 }
 
+template <typename T>
+const T &Deque<T>::at(size_t pos) const {
+    if (pos >= count) {
+        throw std::out_of_range("At");
+    }
+    return (*this)[pos];
+}
+
+template <typename T>
+T &Deque<T>::front() {
+    if (count == 0) throw std::out_of_range("Deque is empty");
+    return slot(start);
+}
+
+template <typename T>
+const T &Deque<T>::front() const {
+    if (count == 0) throw std::out_of_range("Deque is empty");
+    return slot(start);
+}
+
+template <typename T>
+T &Deque<T>::back() {
+    if (count == 0) throw std::out_of_range("Deque is empty");
+    return slot(start + count - 1);
+}
+
+template <typename T>
+const T &Deque<T>::back() const {
+    if (count == 0) throw std::out_of_range("Deque is empty");
+    return slot(start + count - 1);
+}
+
+template <typename T>
+T *Deque<T>::take_block() {
+    if (spare) return std::exchange(spare, nullptr);
+    if (pool) return static_cast<T *>(pool->allocate());
+    return std::allocator<T>().allocate(block_size);
+}
+
+template <typename T>
+void Deque<T>::free_block(T *block) noexcept {
+    if (pool) pool->deallocate(block);
+    else std::allocator<T>().deallocate(block, block_size);
+}
+
+template <typename T>
+void Deque<T>::release_block(std::size_t block) noexcept {
+    T *b = std::exchange(map[block], nullptr);
+    if (!spare) spare = b;
+    else free_block(b);
+}
+
+// Moves the used part of the map to the middle, growing the map when less
+// than half of it would be free.
+template <typename T>
+void Deque<T>::recenter_map() {
+    std::size_t first = start >> block_shift;
+    std::size_t used = count ? ((start + count - 1) >> block_shift) - first + 1 : 0;
+    std::size_t new_capacity = map_capacity;
+    if (2 * (used + 1) > map_capacity) new_capacity = std::max<std::size_t>({8, 2 * map_capacity, 2 * used + 2});
+    std::size_t offset = (new_capacity - used) / 2;
+    if (new_capacity == map_capacity) {
+        std::memmove(map + offset, map + first, used * sizeof(T *));
+        std::fill(map, map + offset, nullptr);
+        std::fill(map + offset + used, map + map_capacity, nullptr);
+    } else {
+        T **new_map = std::allocator<T *>().allocate(new_capacity + 1);
+        std::fill(new_map, new_map + new_capacity + 1, nullptr);
+        if (used) std::memcpy(new_map + offset, map + first, used * sizeof(T *));
+        if (map) std::allocator<T *>().deallocate(map, map_capacity + 1);
+        map = new_map;
+        map_capacity = new_capacity;
+    }
+    start = (offset << block_shift) + (count ? (start & block_mask) : 0);
+}
+
+template <typename T>
+template <typename... Args>
+T &Deque<T>::emplace_back(Args &&...args) {
+    if (((start + count) >> block_shift) >= map_capacity) recenter_map();
+    std::size_t pos = start + count;
+    T *&block = map[pos >> block_shift];
+    bool fresh = !block;
+    if (fresh) block = take_block();
+    try {
+        ::new (static_cast<void *>(block + (pos & block_mask))) T(std::forward<Args>(args)...);
+    } catch (...) {
+        if (fresh) release_block(pos >> block_shift);
+        throw;
+    }
+    ++count;
+    return block[pos & block_mask];
+}
+
+template <typename T>
+template <typename... Args>
+T &Deque<T>::emplace_front(Args &&...args) {
+    if (start == 0) recenter_map();
+    std::size_t pos = start - 1;
+    T *&block = map[pos >> block_shift];
+    bool fresh = !block;
+    if (fresh) block = take_block();
+    try {
+        ::new (static_cast<void *>(block + (pos & block_mask))) T(std::forward<Args>(args)...);
+    } catch (...) {
+        if (fresh) release_block(pos >> block_shift);
+        throw;
+    }
+    start = pos;
+    ++count;
+    return block[pos & block_mask];
+}
+
+template <typename T>
+void Deque<T>::pop_back() {
+    if (count == 0) return;
+    std::size_t pos = start + --count;
+    std::destroy_at(&slot(pos));
+    if (count == 0 || (pos & block_mask) == 0) release_block(pos >> block_shift);
+}
+
+template <typename T>
+void Deque<T>::pop_front() {
+    if (count == 0) return;
+    std::size_t pos = start++;
+    --count;
+    std::destroy_at(&slot(pos));
+    if (count == 0 || (start & block_mask) == 0) release_block(pos >> block_shift);
+}
+
+// Shifts the elements on the shorter side of pos by one slot.
+template <typename T>
+template <typename... Args>
+typename Deque<T>::iterator Deque<T>::emplace(const_iterator pos, Args &&...args) {
+    auto index = static_cast<std::size_t>(pos - cbegin());
+    if (index == 0) {
+        emplace_front(std::forward<Args>(args)...);
+        return begin();
+    }
+    if (index == count) {
+        emplace_back(std::forward<Args>(args)...);
+        return end() - 1;
+    }
+    T value(std::forward<Args>(args)...);
+    if (index < count / 2) {
+        emplace_front(std::move(front()));
+        std::move(begin() + 2, begin() + index + 1, begin() + 1);
+    } else {
+        emplace_back(std::move(back()));
+        std::move_backward(begin() + index, end() - 2, end() - 1);
+    }
+    (*this)[index] = std::move(value);
+    return begin() + index;
+}
+
+template <typename T>
+typename Deque<T>::iterator Deque<T>::erase(const_iterator first, const_iterator last) {
+    auto index = static_cast<std::size_t>(first - cbegin());
+    std::size_t n = static_cast<std::size_t>(last - first);
+    if (n == 0) return begin() + index;
+    if (index < (count - n) / 2) {
+        std::move_backward(begin(), begin() + index, begin() + index + n);
+        for (std::size_t i = 0; i < n; ++i) pop_front();
+    } else {
+        std::move(begin() + index + n, end(), begin() + index);
+        for (std::size_t i = 0; i < n; ++i) pop_back();
+    }
+    return begin() + index;
+}
+
+// Appends [first, last) at the end nearer to index and rotates the new
+// elements into place. If an element throws while being added, the ones
+// already added are removed again.
+template <typename T>
+template <typename It>
+void Deque<T>::insert_at(std::size_t index, It first, It last) {
+    bool at_front = index < count - index;
+    std::size_t old_count = count;
+    try {
+        if (at_front) {
+            while (first != last) emplace_front(*--last);
+            std::size_t n = count - old_count;
+            std::rotate(begin(), begin() + n, begin() + n + index);
+        } else {
+            for (; first != last; ++first) emplace_back(*first);
+            std::rotate(begin() + index, begin() + old_count, end());
+        }
+    } catch (...) {
+        while (count > old_count) at_front ? pop_front() : pop_back();
+        throw;
+    }
+}
+
+template <typename T>
+bool Deque<T>::locate(const T *pos, std::size_t &index) const noexcept {
+    if (count == 0) return false;
+    std::less<const T *> less;
+    std::size_t first = start >> block_shift;
+    std::size_t last = (start + count - 1) >> block_shift;
+    for (std::size_t b = first; b <= last; ++b) {
+        const T *from = map[b] + (b == first ? (start & block_mask) : 0);
+        const T *to = map[b] + (b == last ? ((start + count - 1) & block_mask) + 1 : block_size);
+        if (!less(pos, from) && less(pos, to)) {
+            index = (b << block_shift) + static_cast<std::size_t>(pos - map[b]) - start;
+            return true;
+        }
+    }
+    return false;
+}
+
+template <typename T>
+T *Deque<T>::insert(const T *pos, const T &value) {
+    if (!pos) return &emplace_front(value);
+    if (count && pos == &back() + 1) return &emplace_back(value);
+    std::size_t index;
+    if (!locate(pos, index)) return nullptr;
+    return &*emplace(cbegin() + index, value);
+}
+
+template <typename T>
+T *Deque<T>::erase(const T *pos) {
+    std::size_t index;
+    if (!locate(pos, index)) return nullptr;
+    erase(cbegin() + index);
+    return index < count ? &(*this)[index] : nullptr;
+}
+
+template <typename T>
+void Deque<T>::splice(const_iterator pos, Deque &other) {
+    if (&other == this || other.count == 0) return;
+    insert_at(static_cast<std::size_t>(pos - cbegin()), std::make_move_iterator(other.begin()),
+              std::make_move_iterator(other.end()));
+    other.clear();
+}
+
+template <typename T>
+void Deque<T>::splice(const_iterator pos, Deque &other, const_iterator it) {
+    splice_range(pos, other, it, it + 1);
+}
+
+// Within one deque the range is rotated into place; pos must not lie inside
+// [first, last).
+template <typename T>
+void Deque<T>::splice_range(const_iterator pos, Deque &other, const_iterator first, const_iterator last) {
+    if (first == last) return;
+    auto at = static_cast<std::size_t>(pos - cbegin());
+    if (&other == this) {
+        auto from = static_cast<std::size_t>(first - cbegin());
+        auto to = static_cast<std::size_t>(last - cbegin());
+        if (at < from) std::rotate(begin() + at, begin() + from, begin() + to);
+        else if (at > to) std::rotate(begin() + from, begin() + to, begin() + at);
+        return;
+    }
+    auto from = static_cast<std::size_t>(first - other.cbegin());
+    auto to = static_cast<std::size_t>(last - other.cbegin());
+    insert_at(at, std::make_move_iterator(other.begin() + from), std::make_move_iterator(other.begin() + to));
+    other.erase(other.cbegin() + from, other.cbegin() + to);
+}
+
+template <typename T>
+template <typename Compare>
+void Deque<T>::merge(Deque &other, Compare comp) {
+    if (&other == this || other.count == 0) return;
+    std::size_t old_count = count;
+    try {
+        for (T &item : other) emplace_back(std::move(item));
+    } catch (...) {
+        while (count > old_count) pop_back();
+        throw;
+    }
+    other.clear();
+    std::inplace_merge(begin(), begin() + old_count, end(), comp);
+}
+
+template <typename T>
+template <typename BinaryPredicate>
+std::size_t Deque<T>::unique(BinaryPredicate pred) {
+    iterator last = std::unique(begin(), end(), pred);
+    auto removed = static_cast<std::size_t>(end() - last);
+    erase(last, end());
+    return removed;
+}
+
+template <typename T>
+void Deque<T>::resize(std::size_t new_size, const T &value) {
+    while (count > new_size) pop_back();
+    while (count < new_size) push_back(value);
+}
+
+template <typename T>
+void Deque<T>::destroy_all() noexcept {
+    if (count == 0) return;
+    std::size_t first = start >> block_shift;
+    std::size_t last = (start + count - 1) >> block_shift;
+    for (std::size_t b = first; b <= last; ++b) {
+        std::size_t from = b == first ? (start & block_mask) : 0;
+        std::size_t to = b == last ? ((start + count - 1) & block_mask) + 1 : block_size;
+        std::destroy(map[b] + from, map[b] + to);
+        release_block(b);
+    }
+    count = 0;
+}
+
+template <typename T>
+void Deque<T>::free_storage() noexcept {
+    destroy_all();
+    shrink_to_fit();
+    if (map) std::allocator<T *>().deallocate(map, map_capacity + 1);
+    map = nullptr;
+    map_capacity = 0;
+}
+
+template <typename T>
+void Deque<T>::clear() noexcept {
+    destroy_all();
+}
+
+template <typename T>
+void Deque<T>::shrink_to_fit() noexcept {
+    if (spare) free_block(std::exchange(spare, nullptr));
+}
+
+template <typename T>
+void Deque<T>::swap(Deque &other) noexcept {
+    std::swap(map, other.map);
+    std::swap(map_capacity, other.map_capacity);
+    std::swap(start, other.start);
+    std::swap(count, other.count);
+    std::swap(spare, other.spare);
+    std::swap(pool, other.pool);
+}
+
+static_assert(std::random_access_iterator<Deque<int>::iterator>);
+static_assert(std::random_access_iterator<Deque<int>::const_iterator>);
 
 #endif //DEQUE_DEQUE_HPP
@@ -0,0 +1,208 @@
+#ifndef HAZARDPOINTER_HAZARDPOINTER_HPP
+#define HAZARDPOINTER_HAZARDPOINTER_HPP
+
+#include <algorithm>
+#include <atomic>
+#include <cstddef>
+#include <mutex>
+#include <utility>
+#include <vector>
+
+#include "threadpool.hpp"
+
+namespace my_container {
+
+    // Hazard pointers (M. Michael, "Hazard Pointers: Safe Memory Reclamation
+    // for Lock-Free Objects") for the lock-free containers. A reader publishes
+    // the node it is about to dereference in a HazardPointer; a writer that
+    // unlinks a node hands it to hazard_retire() instead of deleting it, and
+    // the node is freed only once no published hazard points to it. Because
+    // a retired node cannot be reused while it is protected, a CAS on a
+    // protected pointer is also safe from ABA.
+    class HazardDomain {
+    public:
+        struct alignas(cache_line_size) Record {
+            std::atomic<const void*> hazard{nullptr};
+            std::atomic<bool> active{false};
+            Record* next = nullptr;
+        };
+
+        static HazardDomain& global() {
+            static HazardDomain domain;
+            return domain;
+        }
+
+        HazardDomain(const HazardDomain&) = delete;
+        HazardDomain& operator=(const HazardDomain&) = delete;
+
+        ~HazardDomain() {
+            for (Retired& node : orphans_) node.deleter(node.ptr);
+            Record* rec = records_.load(std::memory_order_relaxed);
+            while (rec) delete std::exchange(rec, rec->next);
+        }
+
+        // Records are never freed while the domain lives, so the list can be
+        // walked without protection. Each thread keeps the last record it
+        // released so that a guard per operation does not walk the list.
+        Record* acquire() {
+            ThreadState& state = local();
+            if (state.cached) return std::exchange(state.cached, nullptr);
+            for (Record* rec = records_.load(std::memory_order_acquire); rec; rec = rec->next) {
+                bool expected = false;
+                if (!rec->active.load(std::memory_order_relaxed) &&
+                    rec->active.compare_exchange_strong(expected, true, std::memory_order_acquire)) {
+                    return rec;
+                }
+            }
+            auto* rec = new Record;
+            rec->active.store(true, std::memory_order_relaxed);
+            Record* head = records_.load(std::memory_order_relaxed);
+            do {
+                rec->next = head;
+            } while (!records_.compare_exchange_weak(head, rec, std::memory_order_release, std::memory_order_relaxed));
+            record_count_.fetch_add(1, std::memory_order_relaxed);
+            return rec;
+        }
+
+        void release(Record* rec) noexcept {
+            rec->hazard.store(nullptr, std::memory_order_release);
+            ThreadState& state = local();
+            if (!state.cached) {
+                state.cached = rec;
+            } else {
+                rec->active.store(false, std::memory_order_release);
+            }
+        }
+
+        void retire(void* ptr, void (*deleter)(void*)) {
+            std::vector<Retired>& retired = local().retired;
+            retired.push_back({ptr, deleter});
+            // Scanning costs O(records + retired), so waiting until the list
+            // outgrows the number of hazards keeps reclamation amortized O(1).
+            if (retired.size() >= 2 * record_count_.load(std::memory_order_relaxed) + 16) scan(retired);
+        }
+
+        // Whether a HazardPointer currently protects ptr. Only a hazard
+        // published before ptr was unlinked can be reported, since protect()
+        // cannot succeed on an unlinked node.
+        bool is_protected(const void* ptr) const noexcept {
+            // Pairs with the fence in HazardPointer::protect, as in scan.
+            std::atomic_thread_fence(std::memory_order_seq_cst);
+            for (Record* rec = records_.load(std::memory_order_acquire); rec; rec = rec->next) {
+                if (rec->hazard.load(std::memory_order_acquire) == ptr) return true;
+            }
+            return false;
+        }
+
+        // Frees every retired node of the calling thread that is not
+        // currently protected.
+        void reclaim() {
+            scan(local().retired);
+        }
+
+    private:
+        struct Retired {
+            void* ptr;
+            void (*deleter)(void*);
+        };
+
+        // Per-thread retired list and cached record. Nodes still retired when
+        // a thread exits are handed to the domain and picked up by the next
+        // scan of any thread.
+        struct ThreadState {
+            std::vector<Retired> retired;
+            Record* cached = nullptr;
+
+            ~ThreadState() {
+                if (cached) cached->active.store(false, std::memory_order_release);
+                if (retired.empty()) return;
+                HazardDomain& domain = global();
+                std::lock_guard lock(domain.orphans_mutex_);
+                domain.orphans_.insert(domain.orphans_.end(), retired.begin(), retired.end());
+                domain.has_orphans_.store(true, std::memory_order_release);
+            }
+        };
+
+        HazardDomain() = default;
+
+        static ThreadState& local() {
+            // Make sure the domain outlives the thread_local of the main thread.
+            global();
+            static thread_local ThreadState state;
+            return state;
+        }
+
+        void scan(std::vector<Retired>& retired) {
+            if (has_orphans_.load(std::memory_order_acquire)) {
+                std::lock_guard lock(orphans_mutex_);
+                retired.insert(retired.end(), orphans_.begin(), orphans_.end());
+                orphans_.clear();
+                has_orphans_.store(false, std::memory_order_relaxed);
+            }
+            // Pairs with the fence in HazardPointer::protect: a hazard set
+            // before the node was unlinked is seen here.
+            std::atomic_thread_fence(std::memory_order_seq_cst);
+            std::vector<const void*> hazards;
+            for (Record* rec = records_.load(std::memory_order_acquire); rec; rec = rec->next) {
+                if (const void* p = rec->hazard.load(std::memory_order_acquire)) hazards.push_back(p);
+            }
+            std::sort(hazards.begin(), hazards.end());
+            auto keep = std::partition(retired.begin(), retired.end(), [&](const Retired& node) {
+                return std::binary_search(hazards.begin(), hazards.end(), node.ptr);
+            });
+            std::vector<Retired> ready(keep, retired.end());
+            retired.erase(keep, retired.end());
+            for (Retired& node : ready) node.deleter(node.ptr);
+        }
+
+        std::atomic<Record*> records_{nullptr};
+        std::atomic<std::size_t> record_count_{0};
+        std::atomic<bool> has_orphans_{false};
+        std::mutex orphans_mutex_;
+        std::vector<Retired> orphans_;
+    };
+
+    // Owns one hazard slot for as long as it lives.
+    class HazardPointer {
+    public:
+        HazardPointer(): record_(HazardDomain::global().acquire()) {}
+
+        HazardPointer(const HazardPointer&) = delete;
+        HazardPointer& operator=(const HazardPointer&) = delete;
+
+        ~HazardPointer() {
+            HazardDomain::global().release(record_);
+        }
+
+        // Loads src and publishes the result, retrying until the published
+        // value is still current, so the returned node cannot be freed until
+        // reset() or destruction.
+        template <typename T>
+        T* protect(const std::atomic<T*>& src) noexcept {
+            T* ptr = src.load(std::memory_order_relaxed);
+            for (;;) {
+                record_->hazard.store(ptr, std::memory_order_relaxed);
+                std::atomic_thread_fence(std::memory_order_seq_cst);
+                T* current = src.load(std::memory_order_acquire);
+                if (current == ptr) return ptr;
+                ptr = current;
+            }
+        }
+
+        void reset() noexcept {
+            record_->hazard.store(nullptr, std::memory_order_release);
+        }
+
+    private:
+        HazardDomain::Record* record_;
+    };
+
+    // Deletes ptr once no HazardPointer protects it.
+    template <typename T>
+    void hazard_retire(T* ptr) {
+        HazardDomain::global().retire(ptr, [](void* p) { delete static_cast<T*>(p); });
+    }
+
+}  // namespace my_container
+
+#endif //HAZARDPOINTER_HAZARDPOINTER_HPP
@@ -0,0 +1,318 @@
+#ifndef DEQUE_INTRUSIVELIST_HPP
+#define DEQUE_INTRUSIVELIST_HPP
+
+#include <atomic>
+#include <cstddef>
+#include <iterator>
+#include <memory>
+#include <stdexcept>
+#include <utility>
+
+// Links embedded in an element so that it can sit in an IntrusiveList. A
+// copied hook starts out unlinked, and a hook unlinks itself when the element
+// is destroyed.
+class ListHook {
+    template <typename T, ListHook T::*Hook>
+    friend class IntrusiveList;
+
+    ListHook *prev;
+    ListHook *next;
+
+public:
+    ListHook() noexcept : prev(nullptr), next(nullptr) {}
+    ListHook(const ListHook &) noexcept : ListHook() {}
+    ListHook &operator=(const ListHook &) noexcept { return *this; }
+    ~ListHook() { unlink(); }
+
+    bool is_linked() const noexcept { return next != nullptr; }
+
+    // Removes the element from whatever list it is in, in constant time.
+    void unlink() noexcept {
+        if (!next) return;
+        prev->next = next;
+        next->prev = prev;
+        prev = next = nullptr;
+    }
+};
+
+// Circular doubly linked list threaded through the ListHook member Hook of
+// its elements. The list never allocates, copies or owns elements: they
+// must outlive their membership. Because elements can unlink themselves,
+// size() walks the list.
+template <typename T, ListHook T::*Hook>
+class IntrusiveList {
+    ListHook root;
+
+    // Offset of Hook inside T. A member pointer can only be applied to a
+    // real T, so it is measured on the first element that passes through
+    // hook_of. Every hook is linked through hook_of, so the offset is known
+    // before owner_of can see a hook.
+    static inline std::atomic<std::ptrdiff_t> hook_offset{-1};
+
+    static ListHook *hook_of(T &value) noexcept {
+        ListHook *h = &(value.*Hook);
+        if (hook_offset.load(std::memory_order_relaxed) < 0) {
+            hook_offset.store(reinterpret_cast<char *>(h) - reinterpret_cast<char *>(std::addressof(value)),
+                              std::memory_order_relaxed);
+        }
+        return h;
+    }
+
+    static T *owner_of(ListHook *h) noexcept {
+        return reinterpret_cast<T *>(reinterpret_cast<char *>(h) - hook_offset.load(std::memory_order_relaxed));
+    }
+
+    static const T *owner_of(const ListHook *h) noexcept {
+        return reinterpret_cast<const T *>(reinterpret_cast<const char *>(h) -
+                                           hook_offset.load(std::memory_order_relaxed));
+    }
+
+    void init() noexcept { root.prev = root.next = &root; }
+
+    // Links h in front of pos, unlinking it first if it is in a list.
+    static void link_before(ListHook *pos, ListHook *h) noexcept {
+        if (h == pos) return;
+        h->unlink();
+        h->prev = pos->prev;
+        h->next = pos;
+        pos->prev->next = h;
+        pos->prev = h;
+    }
+
+    // Takes over the chain of other, which must not be empty.
+    void steal(IntrusiveList &other) noexcept {
+        root.next = other.root.next;
+        root.prev = other.root.prev;
+        root.next->prev = &root;
+        root.prev->next = &root;
+        other.init();
+    }
+
+public:
+    class const_iterator;
+
+    class iterator {
+        friend class IntrusiveList;
+        friend class const_iterator;
+
+    public:
+        using iterator_category = std::bidirectional_iterator_tag;
+        using value_type = T;
+        using difference_type = std::ptrdiff_t;
+        using pointer = T*;
+        using reference = T&;
+
+        iterator() : node(nullptr) {}
+        explicit iterator(ListHook *h) : node(h) {}
+
+        reference operator*() const { return *owner_of(node); }
+        pointer operator->() const { return owner_of(node); }
+
+        iterator &operator++() {
+            node = node->next;
+            return *this;
+        }
+
+        iterator operator++(int) {
+            iterator tmp = *this;
+            ++(*this);
+            return tmp;
+        }
+
+        iterator &operator--() {
+            node = node->prev;
+            return *this;
+        }
+
+        iterator operator--(int) {
+            iterator tmp = *this;
+            --(*this);
+            return tmp;
+        }
+
+        friend bool operator==(const iterator &a, const iterator &b) {
+            return a.node == b.node;
+        }
+
+        friend bool operator!=(const iterator &a, const iterator &b) {
+            return !(a == b);
+        }
+
+    private:
+        ListHook *node;
+    };
+
+    class const_iterator {
+        friend class IntrusiveList;
+
+    public:
+        using iterator_category = std::bidirectional_iterator_tag;
+        using value_type = T;
+        using difference_type = std::ptrdiff_t;
+        using pointer = const T*;
+        using reference = const T&;
+
+        const_iterator() : node(nullptr) {}
+        explicit const_iterator(const ListHook *h) : node(h) {}
+        const_iterator(const iterator &it) : node(it.node) {}
+
+        reference operator*() const { return *owner_of(node); }
+        pointer operator->() const { return owner_of(node); }
+
+        const_iterator &operator++() {
+            node = node->next;
+            return *this;
+        }
+
+        const_iterator operator++(int) {
+            const_iterator tmp = *this;
+            ++(*this);
+            return tmp;
+        }
+
+        const_iterator &operator--() {
+            node = node->prev;
+            return *this;
+        }
+
+        const_iterator operator--(int) {
+            const_iterator tmp = *this;
+            --(*this);
+            return tmp;
+        }
+
+        friend bool operator==(const const_iterator &a, const const_iterator &b) {
+            return a.node == b.node;
+        }
+
+        friend bool operator!=(const const_iterator &a, const const_iterator &b) {
+            return !(a == b);
+        }
+
+    private:
+        const ListHook *node;
+    };
+
+    IntrusiveList() noexcept { init(); }
+
+    IntrusiveList(const IntrusiveList &) = delete;
+    IntrusiveList &operator=(const IntrusiveList &) = delete;
+
+    IntrusiveList(IntrusiveList &&other) noexcept {
+        init();
+        if (!other.empty()) steal(other);
+    }
+
+    IntrusiveList &operator=(IntrusiveList &&other) noexcept {
+        if (this != &other) {
+            clear();
+            if (!other.empty()) steal(other);
+        }
+        return *this;
+    }
+
+    ~IntrusiveList() { clear(); }
+
+    bool empty() const noexcept { return root.next == &root; }
+
+    std::size_t size() const noexcept {
+        std::size_t count = 0;
+        for (const ListHook *h = root.next; h != &root; h = h->next) ++count;
+        return count;
+    }
+
+    iterator begin() noexcept { return iterator(root.next); }
+    iterator end() noexcept { return iterator(&root); }
+
+    const_iterator begin() const noexcept { return const_iterator(root.next); }
+    const_iterator end() const noexcept { return const_iterator(&root); }
+
+    const_iterator cbegin() const noexcept { return begin(); }
+    const_iterator cend() const noexcept { return end(); }
+
+    // Iterator to an element known to be in this list.
+    iterator iterator_to(T &value) noexcept { return iterator(hook_of(value)); }
+    const_iterator iterator_to(const T &value) const noexcept { return const_iterator(&(value.*Hook)); }
+
+    T &front() {
+        if (empty()) throw std::out_of_range("List is empty");
+        return *owner_of(root.next);
+    }
+
+    const T &front() const {
+        if (empty()) throw std::out_of_range("List is empty");
+        return *owner_of(root.next);
+    }
+
+    T &back() {
+        if (empty()) throw std::out_of_range("List is empty");
+        return *owner_of(root.prev);
+    }
+
+    const T &back() const {
+        if (empty()) throw std::out_of_range("List is empty");
+        return *owner_of(root.prev);
+    }
+
+    // An element that is already linked into a list is moved from it.
+    iterator insert(const_iterator pos, T &value) noexcept {
+        ListHook *h = hook_of(value);
+        link_before(const_cast<ListHook *>(pos.node), h);
+        return iterator(h);
+    }
+
+    void push_back(T &value) noexcept { link_before(&root, hook_of(value)); }
+    void push_front(T &value) noexcept { link_before(root.next, hook_of(value)); }
+
+    void pop_back() noexcept {
+        if (!empty()) root.prev->unlink();
+    }
+
+    void pop_front() noexcept {
+        if (!empty()) root.next->unlink();
+    }
+
+    iterator erase(const_iterator pos) noexcept {
+        ListHook *h = const_cast<ListHook *>(pos.node);
+        ListHook *next = h->next;
+        h->unlink();
+        return iterator(next);
+    }
+
+    iterator erase(const_iterator first, const_iterator last) noexcept {
+        while (first != last) first = erase(first);
+        return iterator(const_cast<ListHook *>(last.node));
+    }
+
+    static void remove(T &value) noexcept { hook_of(value)->unlink(); }
+
+    void clear() noexcept {
+        for (ListHook *h = root.next; h != &root;) {
+            ListHook *next = h->next;
+            h->prev = h->next = nullptr;
+            h = next;
+        }
+        init();
+    }
+
+    // Moves all elements of other in front of pos.
+    void splice(const_iterator pos, IntrusiveList &other) noexcept {
+        if (&other == this || other.empty()) return;
+        ListHook *at = const_cast<ListHook *>(pos.node);
+        ListHook *first = other.root.next;
+        ListHook *last = other.root.prev;
+        other.init();
+        first->prev = at->prev;
+        last->next = at;
+        at->prev->next = first;
+        at->prev = last;
+    }
+
+    void swap(IntrusiveList &other) noexcept {
+        IntrusiveList tmp(std::move(other));
+        other = std::move(*this);
+        *this = std::move(tmp);
+    }
+};
+
+#endif //DEQUE_INTRUSIVELIST_HPP
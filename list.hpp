@@ -13,25 +13,12 @@
 #include <stdexcept>
 #include <algorithm>
 #include <compare>
+#include <memory>
+#include <type_traits>
+#include <functional>
 
-template <typename T>
-class Container {
-public:
-    Container() = default;
-    Container(const Container& other) = default;
-    virtual Container& operator=(const Container& other) = 0;
-    virtual ~Container() = 0;
-
-    virtual bool operator==(const Container& other) const = 0;
-    virtual bool operator!=(const Container& other) const = 0;
-
-    virtual std::size_t size() const = 0;
-    virtual std::size_t max_size() const = 0;
-    virtual bool empty() const = 0;
-};
-
-template <typename T>
-Container<T>:: ~Container() = default;
+#include "container.hpp"
+#include "nodepool.hpp"
 
 template<typename T>
 class List : public Container<T> {
@@ -44,11 +31,147 @@ class List : public Container<T> {
                 : data(val), prev(p), next(n) {}
         Node(T &&val, Node *p = nullptr, Node *n = nullptr)
                 : data(std::move(val)), prev(p), next(n) {}
+        template <typename... Args>
+        Node(std::in_place_t, Node *p, Node *n, Args &&...args)
+                : data(std::forward<Args>(args)...), prev(p), next(n) {}
     };
 
+public:
+    using node_pool = NodePool<Node>;
+
+private:
     Node *head;
     Node *tail;
     std::size_t list_size;
+    std::shared_ptr<node_pool> pool;
+
+    template <typename... Args>
+    Node *create_node(Args &&...args) {
+        if (!pool) pool = std::make_shared<node_pool>();
+        void *mem = pool->allocate();
+        try {
+            return ::new (mem) Node(std::forward<Args>(args)...);
+        } catch (...) {
+            pool->deallocate(mem);
+            throw;
+        }
+    }
+
+    void destroy_node(Node *n) noexcept {
+        n->~Node();
+        pool->deallocate(n);
+    }
+
+    // Destroys every node. When no other list shares the pool, the slabs are
+    // recycled in one step instead of freeing the nodes one by one.
+    void destroy_nodes() noexcept {
+        if (!head) return;
+        if (pool.use_count() == 1 && !pool->forwarded()) {
+            if constexpr (!std::is_trivially_destructible_v<T>) {
+                for (Node *curr = head; curr;) {
+                    Node *next = curr->next;
+                    curr->~Node();
+                    curr = next;
+                }
+            }
+            pool->reset();
+        } else {
+            for (Node *curr = head; curr;) {
+                Node *next = curr->next;
+                destroy_node(curr);
+                curr = next;
+            }
+        }
+        head = tail = nullptr;
+        list_size = 0;
+    }
+
+    // Links the chain first..last in front of pos; a null pos means the end.
+    void link_before(Node *pos, Node *first, Node *last) noexcept {
+        Node *prev = pos ? pos->prev : tail;
+        first->prev = prev;
+        last->next = pos;
+        if (prev) prev->next = first;
+        else head = first;
+        if (pos) pos->prev = last;
+        else tail = last;
+    }
+
+    // Detaches the chain first..last without destroying it.
+    void unlink(Node *first, Node *last) noexcept {
+        if (first->prev) first->prev->next = last->next;
+        else head = last->next;
+        if (last->next) last->next->prev = first->prev;
+        else tail = first->prev;
+        first->prev = nullptr;
+        last->next = nullptr;
+    }
+
+    // Makes this list and other allocate from the same pool, merging the two
+    // pools if necessary, so that nodes can move between them.
+    void adopt_pool(List &other) {
+        if (!other.pool) return;
+        auto theirs = node_pool::root(other.pool);
+        if (!pool) {
+            pool = theirs;
+        } else {
+            auto mine = node_pool::root(pool);
+            node_pool::merge(mine, theirs);
+            pool = mine;
+        }
+        other.pool = pool;
+    }
+
+    // Merges two sorted chains linked through next only. Ties keep the node
+    // from a first, which makes the sort stable. If comp throws, no node is
+    // lost: a is left holding the merged part followed by the rest of both
+    // chains, and b is left empty.
+    template <typename Compare>
+    static Node *merge_chains(Node *&a_chain, Node *&b_chain, Compare &comp) {
+        Node *a = a_chain;
+        Node *b = b_chain;
+        Node *first = nullptr;
+        Node **link = &first;
+        try {
+            while (a && b) {
+                if (comp(b->data, a->data)) {
+                    *link = b;
+                    b = b->next;
+                } else {
+                    *link = a;
+                    a = a->next;
+                }
+                link = &(*link)->next;
+            }
+        } catch (...) {
+            *link = a;
+            a_chain = append_chain(first, b);
+            b_chain = nullptr;
+            throw;
+        }
+        *link = a ? a : b;
+        return first;
+    }
+
+    // Links rest after the last node of chain and returns the joined chain.
+    static Node *append_chain(Node *chain, Node *rest) noexcept {
+        if (!chain) return rest;
+        Node *last = chain;
+        while (last->next) last = last->next;
+        last->next = rest;
+        return chain;
+    }
+
+    // Rebuilds the prev pointers and tail after the nodes were relinked
+    // through next only.
+    void relink_prev() noexcept {
+        Node *prev = nullptr;
+        for (Node *curr = head; curr; curr = curr->next) {
+            curr->prev = prev;
+            prev = curr;
+        }
+        tail = prev;
+    }
 
     Node* find_node(const T *pos) const {
         for (Node *curr = head; curr; curr = curr->next) {
@@ -60,12 +183,16 @@ class List : public Container<T> {
 public:
     List() : head(nullptr), tail(nullptr), list_size(0) {}
 
+    // Lists constructed with the same pool share its slabs and free list.
+    explicit List(std::shared_ptr<node_pool> shared_pool)
+            : head(nullptr), tail(nullptr), list_size(0), pool(std::move(shared_pool)) {}
+
     List(const List &other) : List() {
         for (const T &item : other) push_back(item);
     }
 
     List(List &&other) noexcept
-            : head(other.head), tail(other.tail), list_size(other.list_size) {
+            : head(other.head), tail(other.tail), list_size(other.list_size), pool(std::move(other.pool)) {
         other.head = nullptr;
         other.tail = nullptr;
         other.list_size = 0;
@@ -75,7 +202,7 @@ public:
         for (const T &item : init) push_back(item);
     }
 
-    ~List() override { clear(); }
+    ~List() override { destroy_nodes(); }
 
     Container<T>& operator=(const Container<T>& other) override {
         if (this != &other) {
@@ -90,7 +217,8 @@ public:
 
     List &operator=(const List &other) {
         if (this != &other) {
-            List tmp(other);
+            List tmp(pool);
+            for (const T &item : other) tmp.push_back(item);
             swap(tmp);
         }
         return *this;
@@ -98,10 +226,11 @@ public:
 
     List &operator=(List &&other) noexcept {
         if (this != &other) {
-            clear();
+            destroy_nodes();
             head = other.head;
             tail = other.tail;
             list_size = other.list_size;
+            pool = std::move(other.pool);
             other.head = other.tail = nullptr;
             other.list_size = 0;
         }
@@ -113,7 +242,7 @@ public:
     std::size_t max_size() const noexcept override { return std::numeric_limits<std::size_t>::max(); }
 
     void push_back(const T &value) {
-        Node *n = new Node(value, tail);
+        Node *n = create_node(value, tail);
         if (tail) tail->next = n;
         else head = n;
         tail = n;
@@ -121,7 +250,7 @@ public:
     }
 
     void push_back(T &&value) {
-        Node *n = new Node(std::move(value), tail);
+        Node *n = create_node(std::move(value), tail);
         if (tail) tail->next = n;
         else head = n;
         tail = n;
@@ -129,7 +258,7 @@ public:
     }
 
     void push_front(const T &value) {
-        Node *n = new Node(value, nullptr, head);
+        Node *n = create_node(value, nullptr, head);
         if (head) head->prev = n;
         else tail = n;
         head = n;
@@ -137,7 +266,7 @@ public:
     }
 
     void push_front(T &&value) {
-        Node *n = new Node(std::move(value), nullptr, head);
+        Node *n = create_node(std::move(value), nullptr, head);
         if (head) head->prev = n;
         else tail = n;
         head = n;
@@ -150,7 +279,7 @@ public:
         tail = tail->prev;
         if (tail) tail->next = nullptr;
         else head = nullptr;
-        delete to_delete;
+        destroy_node(to_delete);
         --list_size;
     }
 
@@ -160,13 +289,11 @@ public:
         head = head->next;
         if (head) head->prev = nullptr;
         else tail = nullptr;
-        delete to_delete;
+        destroy_node(to_delete);
         --list_size;
     }
 
-    void clear() {
-        while (!empty()) pop_front();
-    }
+    void clear() { destroy_nodes(); }
 
     T &front() {
         if (!head) throw std::out_of_range("List is empty");
@@ -188,7 +315,12 @@ public:
         return tail->data;
     }
 
+    class const_iterator;
+
     class iterator {
+        friend class List;
+        friend class const_iterator;
+
     public:
         using iterator_category = std::bidirectional_iterator_tag;
         using value_type = T;
@@ -235,6 +367,8 @@ public:
         Node *node;
     };
     class const_iterator {
+        friend class List;
+
     public:
         using iterator_category = std::bidirectional_iterator_tag;
         using value_type = T;
@@ -243,6 +377,7 @@ public:
         using reference = const T&;
 
         const_iterator(const Node* ptr) : node(ptr) {}
+        const_iterator(const iterator &it) : node(it.node) {}
 
         reference operator*() const { return node->data; }
         pointer operator->() const { return &node->data; }
@@ -304,7 +439,7 @@ public:
         Node *curr = find_node(pos);
         if (!curr) return nullptr;
 
-        Node *n = new Node(value, curr->prev, curr);
+        Node *n = create_node(value, curr->prev, curr);
         curr->prev->next = n;
         curr->prev = n;
         ++list_size;
@@ -327,11 +462,197 @@ public:
         Node *next = curr->next;
         curr->prev->next = curr->next;
         if (curr->next) curr->next->prev = curr->prev;
-        delete curr;
+        destroy_node(curr);
         --list_size;
         return next ? &next->data : nullptr;
     }
 
+    // Iterator-based modifiers work on the node directly: none of them walks
+    // the list, and splicing never allocates.
+    template <typename... Args>
+    iterator emplace(const_iterator pos, Args &&...args) {
+        Node *n = create_node(std::in_place, nullptr, nullptr, std::forward<Args>(args)...);
+        link_before(const_cast<Node *>(pos.node), n, n);
+        ++list_size;
+        return iterator(n);
+    }
+
+    iterator insert(const_iterator pos, const T &value) {
+        return emplace(pos, value);
+    }
+
+    iterator insert(const_iterator pos, T &&value) {
+        return emplace(pos, std::move(value));
+    }
+
+    iterator erase(const_iterator pos) {
+        Node *n = const_cast<Node *>(pos.node);
+        Node *next = n->next;
+        unlink(n, n);
+        destroy_node(n);
+        --list_size;
+        return iterator(next);
+    }
+
+    iterator erase(const_iterator first, const_iterator last) {
+        while (first != last) first = erase(first);
+        return iterator(const_cast<Node *>(last.node));
+    }
+
+    // Moves all elements of other in front of pos.
+    void splice(const_iterator pos, List &other) {
+        if (&other == this || !other.head) return;
+        adopt_pool(other);
+        link_before(const_cast<Node *>(pos.node), other.head, other.tail);
+        list_size += other.list_size;
+        other.head = other.tail = nullptr;
+        other.list_size = 0;
+    }
+
+    void splice(const_iterator pos, List &&other) {
+        splice(pos, other);
+    }
+
+    // Moves the element at it from other in front of pos.
+    void splice(const_iterator pos, List &other, const_iterator it) {
+        Node *n = const_cast<Node *>(it.node);
+        Node *at = const_cast<Node *>(pos.node);
+        if (n == at || n->next == at) return;
+        if (&other != this) adopt_pool(other);
+        other.unlink(n, n);
+        link_before(at, n, n);
+        if (&other != this) {
+            --other.list_size;
+            ++list_size;
+        }
+    }
+
+    // Moves [first, last) from other in front of pos. Constant time within one
+    // list; between lists the moved elements are counted to keep both sizes.
+    void splice_range(const_iterator pos, List &other, const_iterator first, const_iterator last) {
+        if (first == last) return;
+        Node *from = const_cast<Node *>(first.node);
+        Node *to = last.node ? const_cast<Node *>(last.node)->prev : other.tail;
+        if (&other != this) {
+            std::size_t count = 1;
+            for (Node *curr = from; curr != to; curr = curr->next) ++count;
+            adopt_pool(other);
+            other.list_size -= count;
+            list_size += count;
+        }
+        other.unlink(from, to);
+        link_before(const_cast<Node *>(pos.node), from, to);
+    }
+
+    // Merges the sorted list other into this sorted list by relinking nodes.
+    // Equal elements from this list come first.
+    template <typename Compare>
+    void merge(List &other, Compare comp) {
+        if (&other == this || !other.head) return;
+        adopt_pool(other);
+        if (head) tail->next = nullptr;
+        try {
+            head = merge_chains(head, other.head, comp);
+        } catch (...) {
+            // Every node of both lists is now in head's chain, partly merged.
+            relink_prev();
+            list_size += other.list_size;
+            other.tail = nullptr;
+            other.list_size = 0;
+            throw;
+        }
+        relink_prev();
+        list_size += other.list_size;
+        other.head = other.tail = nullptr;
+        other.list_size = 0;
+    }
+
+    template <typename Compare>
+    void merge(List &&other, Compare comp) {
+        merge(other, comp);
+    }
+
+    void merge(List &other) {
+        merge(other, std::less<>());
+    }
+
+    void merge(List &&other) {
+        merge(other, std::less<>());
+    }
+
+    // Stable bottom-up merge sort. Only the links change, so references and
+    // iterators stay valid and nothing is allocated.
+    template <typename Compare>
+    void sort(Compare comp) {
+        if (list_size < 2) return;
+        // runs[i] is either empty or a sorted chain of 2^i nodes.
+        Node *runs[std::numeric_limits<std::size_t>::digits] = {};
+        std::size_t used = 0;
+        Node *curr = head;
+        try {
+            while (curr) {
+                Node *run = curr;
+                curr = curr->next;
+                run->next = nullptr;
+                std::size_t i = 0;
+                for (; i < used && runs[i]; ++i) {
+                    run = merge_chains(runs[i], run, comp);
+                    runs[i] = nullptr;
+                }
+                runs[i] = run;
+                if (i == used) ++used;
+            }
+            Node *result = nullptr;
+            for (std::size_t i = 0; i < used; ++i) {
+                if (!runs[i]) continue;
+                result = merge_chains(runs[i], result, comp);
+                runs[i] = nullptr;
+            }
+            head = result;
+        } catch (...) {
+            // A failed merge_chains leaves both of its inputs in runs[i], so
+            // the runs and the unsorted rest hold every node exactly once.
+            for (std::size_t i = 0; i < used; ++i) curr = append_chain(runs[i], curr);
+            head = curr;
+            relink_prev();
+            throw;
+        }
+        relink_prev();
+    }
+
+    void sort() {
+        sort(std::less<>());
+    }
+
+    // Removes consecutive elements for which pred holds; returns how many were
+    // removed.
+    template <typename BinaryPredicate>
+    std::size_t unique(BinaryPredicate pred) {
+        std::size_t removed = 0;
+        if (!head) return removed;
+        for (Node *curr = head; curr->next;) {
+            Node *next = curr->next;
+            if (pred(curr->data, next->data)) {
+                unlink(next, next);
+                destroy_node(next);
+                ++removed;
+            } else {
+                curr = next;
+            }
+        }
+        list_size -= removed;
+        return removed;
+    }
+
+    std::size_t unique() {
+        return unique(std::equal_to<>());
+    }
+
+    void reverse() noexcept {
+        for (Node *curr = head; curr; curr = curr->prev) std::swap(curr->prev, curr->next);
+        std::swap(head, tail);
+    }
+
     void resize(std::size_t count, const T &value = T()) {
         while (list_size > count) pop_back();
         while (list_size < count) push_back(value);
@@ -341,6 +662,7 @@ public:
         std::swap(head, other.head);
         std::swap(tail, other.tail);
         std::swap(list_size, other.list_size);
+        std::swap(pool, other.pool);
     }
     bool operator==(const List<T>& other) const {
         if (list_size != other.list_size) return false;
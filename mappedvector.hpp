@@ -0,0 +1,294 @@
+#ifndef MAPPEDVECTOR_MAPPEDVECTOR_HPP
+#define MAPPEDVECTOR_MAPPEDVECTOR_HPP
+
+#include <algorithm>
+#include <cerrno>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <stdexcept>
+#include <string>
+#include <system_error>
+#include <type_traits>
+#include <utility>
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+namespace my_container {
+
+    // Vector of trivially copyable records stored in a memory-mapped file.
+    // Opening an existing file maps the stored elements directly, so a new
+    // process can use them without parsing or copying. POSIX only.
+    template <typename T>
+    class MappedVector {
+        static_assert(std::is_trivially_copyable_v<T>, "MappedVector stores the raw bytes of T");
+        static_assert(alignof(T) <= 64, "MappedVector aligns elements to at most 64 bytes");
+
+    public:
+        MappedVector() = default;
+
+        explicit MappedVector(const std::string& path) {
+            open(path);
+        }
+
+        MappedVector(const MappedVector&) = delete;
+        MappedVector& operator=(const MappedVector&) = delete;
+
+        MappedVector(MappedVector&& other) noexcept
+                : fd_(std::exchange(other.fd_, -1)),
+                  map_(std::exchange(other.map_, nullptr)),
+                  map_bytes_(std::exchange(other.map_bytes_, 0)) {}
+
+        MappedVector& operator=(MappedVector&& other) noexcept {
+            if (this != &other) {
+                close();
+                fd_ = std::exchange(other.fd_, -1);
+                map_ = std::exchange(other.map_, nullptr);
+                map_bytes_ = std::exchange(other.map_bytes_, 0);
+            }
+            return *this;
+        }
+
+        ~MappedVector() {
+            close();
+        }
+
+        // Opens path, creating an empty vector file if it does not exist.
+        void open(const std::string& path) {
+            close();
+            int fd = ::open(path.c_str(), O_RDWR | O_CREAT, 0644);
+            if (fd < 0) throw_errno("open " + path);
+            struct stat st {};
+            if (::fstat(fd, &st) != 0) {
+                int err = errno;
+                ::close(fd);
+                throw std::system_error(err, std::generic_category(), "fstat " + path);
+            }
+            fd_ = fd;
+            try {
+                if (st.st_size == 0) {
+                    resize_file(sizeof(Header));
+                    map(sizeof(Header));
+                    Header* h = header();
+                    h->magic = magic;
+                    h->version = version;
+                    h->element_size = sizeof(T);
+                    h->size = 0;
+                    h->capacity = 0;
+                } else {
+                    if (static_cast<std::size_t>(st.st_size) < sizeof(Header)) {
+                        throw std::runtime_error(path + " is not a MappedVector file");
+                    }
+                    map(static_cast<std::size_t>(st.st_size));
+                    const Header* h = header();
+                    if (h->magic != magic || h->version != version || h->element_size != sizeof(T) ||
+                        sizeof(Header) + h->capacity * sizeof(T) > map_bytes_ || h->size > h->capacity) {
+                        throw std::runtime_error(path + " is not a MappedVector file for this element type");
+                    }
+                }
+            } catch (...) {
+                close();
+                throw;
+            }
+        }
+
+        void close() noexcept {
+            if (map_) ::munmap(map_, map_bytes_);
+            if (fd_ >= 0) ::close(fd_);
+            map_ = nullptr;
+            map_bytes_ = 0;
+            fd_ = -1;
+        }
+
+        bool is_open() const noexcept {
+            return map_ != nullptr;
+        }
+
+        // Writes dirty pages back to the file; with async the call only
+        // schedules the write-back.
+        void flush(bool async = false) {
+            if (map_ && ::msync(map_, map_bytes_, async ? MS_ASYNC : MS_SYNC) != 0) throw_errno("msync");
+        }
+
+        T& operator[](std::size_t index) {
+            return data()[index];
+        }
+
+        const T& operator[](std::size_t index) const {
+            return data()[index];
+        }
+
+        T& at(std::size_t index) {
+            if (index >= size()) throw std::out_of_range("Index out of range");
+            return data()[index];
+        }
+
+        const T& at(std::size_t index) const {
+            if (index >= size()) throw std::out_of_range("Index out of range");
+            return data()[index];
+        }
+
+        T& front() {
+            return data()[0];
+        }
+
+        const T& front() const {
+            return data()[0];
+        }
+
+        T& back() {
+            return data()[size() - 1];
+        }
+
+        const T& back() const {
+            return data()[size() - 1];
+        }
+
+        T* data() noexcept {
+            return map_ ? reinterpret_cast<T*>(static_cast<char*>(map_) + sizeof(Header)) : nullptr;
+        }
+
+        const T* data() const noexcept {
+            return map_ ? reinterpret_cast<const T*>(static_cast<const char*>(map_) + sizeof(Header)) : nullptr;
+        }
+
+        T* begin() noexcept {
+            return data();
+        }
+
+        const T* begin() const noexcept {
+            return data();
+        }
+
+        T* end() noexcept {
+            return data() + size();
+        }
+
+        const T* end() const noexcept {
+            return data() + size();
+        }
+
+        bool empty() const noexcept {
+            return size() == 0;
+        }
+
+        std::size_t size() const noexcept {
+            return map_ ? static_cast<std::size_t>(header()->size) : 0;
+        }
+
+        std::size_t capacity() const noexcept {
+            return map_ ? static_cast<std::size_t>(header()->capacity) : 0;
+        }
+
+        // Grows the backing file so that it holds new_cap elements.
+        void reserve(std::size_t new_cap) {
+            require_open();
+            if (new_cap <= capacity()) return;
+            std::size_t bytes = sizeof(Header) + new_cap * sizeof(T);
+            resize_file(bytes);
+            remap(bytes);
+            header()->capacity = new_cap;
+        }
+
+        void push_back(const T& value) {
+            require_open();
+            std::size_t n = size();
+            if (n == capacity()) {
+                T tmp = value;
+                reserve(n == 0 ? initial_capacity() : n * 2);
+                data()[n] = tmp;
+            } else {
+                data()[n] = value;
+            }
+            header()->size = n + 1;
+        }
+
+        void pop_back() {
+            if (size() > 0) --header()->size;
+        }
+
+        void clear() {
+            if (map_) header()->size = 0;
+        }
+
+        void resize(std::size_t count, const T& value = T()) {
+            require_open();
+            std::size_t n = size();
+            if (count > n) {
+                T tmp = value;
+                reserve(count);
+                std::fill(data() + n, data() + count, tmp);
+            }
+            header()->size = count;
+        }
+
+    private:
+        struct alignas(64) Header {
+            std::uint64_t magic;
+            std::uint32_t version;
+            std::uint32_t element_size;
+            std::uint64_t size;
+            std::uint64_t capacity;
+        };
+
+        static constexpr std::uint64_t magic = 0x524f544345564d4dull;  // "MMVECTOR"
+        static constexpr std::uint32_t version = 1;
+
+        static std::size_t initial_capacity() noexcept {
+            std::size_t page = static_cast<std::size_t>(::sysconf(_SC_PAGESIZE));
+            return std::max<std::size_t>((page - sizeof(Header)) / sizeof(T), 1);
+        }
+
+        [[noreturn]] static void throw_errno(const std::string& what) {
+            throw std::system_error(errno, std::generic_category(), what);
+        }
+
+        Header* header() noexcept {
+            return static_cast<Header*>(map_);
+        }
+
+        const Header* header() const noexcept {
+            return static_cast<const Header*>(map_);
+        }
+
+        void require_open() const {
+            if (!map_) throw std::logic_error("MappedVector is not open");
+        }
+
+        void resize_file(std::size_t bytes) {
+            if (::ftruncate(fd_, static_cast<off_t>(bytes)) != 0) throw_errno("ftruncate");
+        }
+
+        void map(std::size_t bytes) {
+            void* p = ::mmap(nullptr, bytes, PROT_READ | PROT_WRITE, MAP_SHARED, fd_, 0);
+            if (p == MAP_FAILED) throw_errno("mmap");
+            map_ = p;
+            map_bytes_ = bytes;
+        }
+
+        void remap(std::size_t bytes) {
+#ifdef MREMAP_MAYMOVE
+            void* p = ::mremap(map_, map_bytes_, bytes, MREMAP_MAYMOVE);
+            if (p == MAP_FAILED) throw_errno("mremap");
+            map_ = p;
+            map_bytes_ = bytes;
+#else
+            void* p = ::mmap(nullptr, bytes, PROT_READ | PROT_WRITE, MAP_SHARED, fd_, 0);
+            if (p == MAP_FAILED) throw_errno("mmap");
+            ::munmap(map_, map_bytes_);
+            map_ = p;
+            map_bytes_ = bytes;
+#endif
+        }
+
+        int fd_ = -1;
+        void* map_ = nullptr;
+        std::size_t map_bytes_ = 0;
+    };
+
+}  // namespace my_container
+
+#endif //MAPPEDVECTOR_MAPPEDVECTOR_HPP
@@ -0,0 +1,522 @@
+#ifndef MDARRAY_MDARRAY_HPP
+#define MDARRAY_MDARRAY_HPP
+
+#include <array>
+#include <cstddef>
+#include <stdexcept>
+#include <type_traits>
+
+#include "array.hpp"
+
+template <std::size_t Rank>
+using MdIndex = std::array<std::size_t, Rank>;
+
+namespace mdarray_detail {
+
+    // Steps idx to the next position in [0, extents), the last dimension
+    // changing fastest when last_fastest is set and the first otherwise.
+    template <std::size_t Rank>
+    constexpr bool next(MdIndex<Rank>& idx, const MdIndex<Rank>& extents, bool last_fastest) {
+        for (std::size_t k = 0; k < Rank; ++k) {
+            std::size_t dim = last_fastest ? Rank - 1 - k : k;
+            if (++idx[dim] < extents[dim]) return true;
+            idx[dim] = 0;
+        }
+        return false;
+    }
+
+    template <std::size_t Rank, typename F>
+    constexpr void walk(const MdIndex<Rank>& extents, bool last_fastest, F&& f) {
+        for (std::size_t extent : extents) {
+            if (extent == 0) return;
+        }
+        MdIndex<Rank> idx{};
+        do {
+            f(idx);
+        } while (next(idx, extents, last_fastest));
+    }
+
+}  // namespace mdarray_detail
+
+// Layout policies. Layout::mapping<Extents...> maps an index to a storage
+// offset and provides
+//   rank, extents      - the logical shape;
+//   required_size      - the number of storage elements, padding included;
+//   offset(idx)        - the storage position of idx;
+//   for_each_index(f)  - every index in storage order;
+//   strided, stride(d) - whether offset is linear in the index, and its
+//                        coefficients;
+//   last_fastest       - whether walking the last dimension fastest is the
+//                        cache-friendly order;
+//   tile               - for layouts that are not strided, the edge of the
+//                        blocks that are stored one after another, each
+//                        row-major, in row-major block order.
+
+// C order: the last index is contiguous.
+struct RowMajor {
+    template <std::size_t... Extents>
+    struct mapping {
+        static constexpr std::size_t rank = sizeof...(Extents);
+        static constexpr MdIndex<rank> extents{Extents...};
+        static constexpr std::size_t required_size = (Extents * ...);
+        static constexpr bool strided = true;
+        static constexpr bool last_fastest = true;
+
+        static constexpr std::size_t stride(std::size_t dim) noexcept {
+            std::size_t result = 1;
+            for (std::size_t d = dim + 1; d < rank; ++d) result *= extents[d];
+            return result;
+        }
+
+        static constexpr std::size_t offset(const MdIndex<rank>& idx) noexcept {
+            std::size_t result = 0;
+            for (std::size_t d = 0; d < rank; ++d) result = result * extents[d] + idx[d];
+            return result;
+        }
+
+        template <typename F>
+        static constexpr void for_each_index(F&& f) {
+            mdarray_detail::walk(extents, last_fastest, f);
+        }
+    };
+};
+
+// Fortran order: the first index is contiguous.
+struct ColumnMajor {
+    template <std::size_t... Extents>
+    struct mapping {
+        static constexpr std::size_t rank = sizeof...(Extents);
+        static constexpr MdIndex<rank> extents{Extents...};
+        static constexpr std::size_t required_size = (Extents * ...);
+        static constexpr bool strided = true;
+        static constexpr bool last_fastest = false;
+
+        static constexpr std::size_t stride(std::size_t dim) noexcept {
+            std::size_t result = 1;
+            for (std::size_t d = 0; d < dim; ++d) result *= extents[d];
+            return result;
+        }
+
+        static constexpr std::size_t offset(const MdIndex<rank>& idx) noexcept {
+            std::size_t result = 0;
+            for (std::size_t d = rank; d-- > 0;) result = result * extents[d] + idx[d];
+            return result;
+        }
+
+        template <typename F>
+        static constexpr void for_each_index(F&& f) {
+            mdarray_detail::walk(extents, last_fastest, f);
+        }
+    };
+};
+
+// Blocked layout: the grid is cut into Tile x ... x Tile blocks stored one
+// after another in row-major block order, each block itself row-major.
+// Neighbours along any dimension are then at most one block apart, which
+// keeps column-wise and stencil access in cache. Extents that are not a
+// multiple of Tile are padded up to one.
+template <std::size_t Tile>
+struct Tiled {
+    static_assert(Tile > 0, "Tile must not be empty");
+
+    template <std::size_t... Extents>
+    struct mapping {
+        static constexpr std::size_t rank = sizeof...(Extents);
+        static constexpr MdIndex<rank> extents{Extents...};
+        static constexpr MdIndex<rank> tiles{(Extents + Tile - 1) / Tile...};
+        static constexpr std::size_t tile_size = [] {
+            std::size_t result = 1;
+            for (std::size_t d = 0; d < rank; ++d) result *= Tile;
+            return result;
+        }();
+        static constexpr std::size_t required_size = (((Extents + Tile - 1) / Tile) * ...) * tile_size;
+        static constexpr bool strided = false;
+        static constexpr bool last_fastest = true;
+        static constexpr std::size_t tile = Tile;
+
+        static constexpr std::size_t offset(const MdIndex<rank>& idx) noexcept {
+            std::size_t block = 0;
+            std::size_t inner = 0;
+            for (std::size_t d = 0; d < rank; ++d) {
+                block = block * tiles[d] + idx[d] / Tile;
+                inner = inner * Tile + idx[d] % Tile;
+            }
+            return block * tile_size + inner;
+        }
+
+        template <typename F>
+        static constexpr void for_each_index(F&& f) {
+            mdarray_detail::walk(tiles, true, [&](const MdIndex<rank>& tile) {
+                MdIndex<rank> box{};
+                for (std::size_t d = 0; d < rank; ++d) {
+                    box[d] = extents[d] - tile[d] * Tile < Tile ? extents[d] - tile[d] * Tile : Tile;
+                }
+                mdarray_detail::walk(box, true, [&](const MdIndex<rank>& inner) {
+                    MdIndex<rank> idx{};
+                    for (std::size_t d = 0; d < rank; ++d) idx[d] = tile[d] * Tile + inner[d];
+                    f(idx);
+                });
+            });
+        }
+    };
+};
+
+// Non-owning view of Rank dimensions of an array laid out by Mapping. Each
+// view dimension selects one dimension of the underlying array and walks it
+// from an origin with a step, so sub-blocks, every n-th element and
+// lower-rank slices are all views. For strided layouts the offset is
+// precomputed as base + sum(idx * stride).
+template <typename T, typename Mapping, std::size_t Rank = Mapping::rank>
+class MdView {
+public:
+    using value_type = std::remove_cv_t<T>;
+    using index_type = MdIndex<Rank>;
+    using parent_index = MdIndex<Mapping::rank>;
+
+    static constexpr std::size_t rank = Rank;
+
+    // dims[k] is the array dimension that view dimension k walks; they must
+    // be increasing.
+    constexpr MdView(T* data, const parent_index& origin, const index_type& extents, const index_type& steps,
+                     const index_type& dims)
+            : data_(data), origin_(origin), extents_(extents), steps_(steps), dims_(dims) {
+        if constexpr (Mapping::strided) {
+            base_ = Mapping::offset(origin_);
+            for (std::size_t k = 0; k < Rank; ++k) strides_[k] = Mapping::stride(dims_[k]) * steps_[k];
+        }
+    }
+
+    constexpr std::size_t extent(std::size_t dim) const noexcept {
+        return extents_[dim];
+    }
+
+    constexpr std::size_t size() const noexcept {
+        std::size_t result = 1;
+        for (std::size_t extent : extents_) result *= extent;
+        return result;
+    }
+
+    constexpr bool empty() const noexcept {
+        return size() == 0;
+    }
+
+    template <typename... Indices>
+        requires(sizeof...(Indices) == Rank && (std::is_convertible_v<Indices, std::size_t> && ...))
+    constexpr T& operator()(Indices... idx) const {
+        return data_[offset(index_type{static_cast<std::size_t>(idx)...})];
+    }
+
+    constexpr T& operator[](const index_type& idx) const {
+        return data_[offset(idx)];
+    }
+
+    template <typename... Indices>
+        requires(sizeof...(Indices) == Rank && (std::is_convertible_v<Indices, std::size_t> && ...))
+    constexpr T& at(Indices... idx) const {
+        index_type index{static_cast<std::size_t>(idx)...};
+        for (std::size_t k = 0; k < Rank; ++k) {
+            if (index[k] >= extents_[k]) {
+                throw std::out_of_range("Index out of range");
+            }
+        }
+        return data_[offset(index)];
+    }
+
+    // View of extents[k] elements along each dimension, starting at
+    // offsets[k] and taking every steps[k]-th one.
+    constexpr MdView subview(const index_type& offsets, const index_type& extents, const index_type& steps) const {
+        parent_index origin = origin_;
+        index_type new_steps{};
+        for (std::size_t k = 0; k < Rank; ++k) {
+            if (steps[k] == 0 || (extents[k] > 0 && offsets[k] + (extents[k] - 1) * steps[k] >= extents_[k])) {
+                throw std::out_of_range("Index out of range");
+            }
+            origin[dims_[k]] += offsets[k] * steps_[k];
+            new_steps[k] = steps_[k] * steps[k];
+        }
+        return MdView(data_, origin, extents, new_steps, dims_);
+    }
+
+    constexpr MdView subview(const index_type& offsets, const index_type& extents) const {
+        index_type steps{};
+        for (std::size_t& step : steps) step = 1;
+        return subview(offsets, extents, steps);
+    }
+
+    // Fixes dimension dim at index, dropping it from the view.
+    constexpr MdView<T, Mapping, Rank - 1> slice(std::size_t dim, std::size_t index) const
+        requires(Rank > 1) {
+        if (dim >= Rank || index >= extents_[dim]) {
+            throw std::out_of_range("Index out of range");
+        }
+        parent_index origin = origin_;
+        origin[dims_[dim]] += index * steps_[dim];
+        MdIndex<Rank - 1> extents{}, steps{}, dims{};
+        for (std::size_t k = 0, j = 0; k < Rank; ++k) {
+            if (k == dim) continue;
+            extents[j] = extents_[k];
+            steps[j] = steps_[k];
+            dims[j] = dims_[k];
+            ++j;
+        }
+        return MdView<T, Mapping, Rank - 1>(data_, origin, extents, steps, dims);
+    }
+
+    // Visits every element in storage order of the underlying layout.
+    template <typename F>
+    constexpr void for_each(F&& f) const {
+        walk([&](const index_type& idx) { f(data_[offset(idx)]); });
+    }
+
+    // Same as for_each, but f also receives the view index of the element.
+    template <typename F>
+    constexpr void for_each_indexed(F&& f) const {
+        walk([&](const index_type& idx) { f(idx, data_[offset(idx)]); });
+    }
+
+private:
+    // Calls g with every view index in increasing order of offset. For a
+    // blocked layout each view dimension is cut into runs of indices that
+    // fall into the same tile; the runs are visited in row-major order and
+    // the indices of each box of runs row-major, as the tiles are stored.
+    template <typename G>
+    constexpr void walk(G&& g) const {
+        if constexpr (Mapping::strided) {
+            mdarray_detail::walk(extents_, Mapping::last_fastest, g);
+        } else {
+            if (empty()) return;
+            index_type lo{}, hi{}, box{};
+            for (std::size_t k = 0; k < Rank; ++k) hi[k] = run_end(k, 0);
+            bool more = true;
+            while (more) {
+                for (std::size_t k = 0; k < Rank; ++k) box[k] = hi[k] - lo[k];
+                mdarray_detail::walk(box, true, [&](const index_type& inner) {
+                    index_type idx{};
+                    for (std::size_t k = 0; k < Rank; ++k) idx[k] = lo[k] + inner[k];
+                    g(idx);
+                });
+                more = false;
+                for (std::size_t k = Rank; k-- > 0 && !more;) {
+                    more = hi[k] < extents_[k];
+                    lo[k] = more ? hi[k] : 0;
+                    hi[k] = run_end(k, lo[k]);
+                }
+            }
+        }
+    }
+
+    // End of the run of view indices from begin along dimension k that lie
+    // in the same tile as begin.
+    constexpr std::size_t run_end(std::size_t k, std::size_t begin) const noexcept {
+        std::size_t coord = origin_[dims_[k]] + begin * steps_[k];
+        std::size_t next_tile = (coord / Mapping::tile + 1) * Mapping::tile;
+        std::size_t end = begin + (next_tile - coord + steps_[k] - 1) / steps_[k];
+        return end < extents_[k] ? end : extents_[k];
+    }
+
+    constexpr std::size_t offset(const index_type& idx) const noexcept {
+        if constexpr (Mapping::strided) {
+            std::size_t result = base_;
+            for (std::size_t k = 0; k < Rank; ++k) result += idx[k] * strides_[k];
+            return result;
+        } else {
+            parent_index parent = origin_;
+            for (std::size_t k = 0; k < Rank; ++k) parent[dims_[k]] += idx[k] * steps_[k];
+            return Mapping::offset(parent);
+        }
+    }
+
+    T* data_;
+    parent_index origin_;
+    index_type extents_;
+    index_type steps_;
+    index_type dims_;
+    std::size_t base_ = 0;
+    index_type strides_{};
+};
+
+// Fixed-size multi-dimensional array stored in one Array and laid out by
+// Layout (RowMajor, ColumnMajor or Tiled<N>). Like Array it is an aggregate
+// and usable in constant expressions. Elements are visited in storage order
+// by for_each; views and slices refer to the array without copying it.
+template <typename T, typename Layout, std::size_t... Extents>
+struct BasicMdArray {
+    using mapping_type = typename Layout::template mapping<Extents...>;
+    static constexpr std::size_t rank = sizeof...(Extents);
+    using index_type = MdIndex<rank>;
+    using view_type = MdView<T, mapping_type>;
+    using const_view_type = MdView<const T, mapping_type>;
+
+    static_assert(rank > 0 && ((Extents > 0) && ...), "MdArray extents must not be empty");
+
+    Array<T, mapping_type::required_size> m_data;
+
+    static constexpr std::size_t extent(std::size_t dim) noexcept {
+        return mapping_type::extents[dim];
+    }
+
+    static constexpr std::size_t size() noexcept {
+        return (Extents * ...);
+    }
+
+    // Number of storage elements, including the padding of a tiled layout.
+    static constexpr std::size_t storage_size() noexcept {
+        return mapping_type::required_size;
+    }
+
+    template <typename... Indices>
+        requires(sizeof...(Indices) == rank && (std::is_convertible_v<Indices, std::size_t> && ...))
+    constexpr T& operator()(Indices... idx) {
+        return m_data[mapping_type::offset(index_type{static_cast<std::size_t>(idx)...})];
+    }
+
+    template <typename... Indices>
+        requires(sizeof...(Indices) == rank && (std::is_convertible_v<Indices, std::size_t> && ...))
+    constexpr const T& operator()(Indices... idx) const {
+        return m_data[mapping_type::offset(index_type{static_cast<std::size_t>(idx)...})];
+    }
+
+    constexpr T& operator[](const index_type& idx) {
+        return m_data[mapping_type::offset(idx)];
+    }
+
+    constexpr const T& operator[](const index_type& idx) const {
+        return m_data[mapping_type::offset(idx)];
+    }
+
+    template <typename... Indices>
+        requires(sizeof...(Indices) == rank && (std::is_convertible_v<Indices, std::size_t> && ...))
+    constexpr T& at(Indices... idx) {
+        return m_data[checked_offset(index_type{static_cast<std::size_t>(idx)...})];
+    }
+
+    template <typename... Indices>
+        requires(sizeof...(Indices) == rank && (std::is_convertible_v<Indices, std::size_t> && ...))
+    constexpr const T& at(Indices... idx) const {
+        return m_data[checked_offset(index_type{static_cast<std::size_t>(idx)...})];
+    }
+
+    constexpr T* data() noexcept {
+        return m_data.data();
+    }
+
+    constexpr const T* data() const noexcept {
+        return m_data.data();
+    }
+
+    constexpr void fill(const T& value) {
+        m_data.fill(value);
+    }
+
+    constexpr view_type view() noexcept {
+        return view_type(data(), index_type{}, mapping_type::extents, ones(), dimensions());
+    }
+
+    constexpr const_view_type view() const noexcept {
+        return const_view_type(data(), index_type{}, mapping_type::extents, ones(), dimensions());
+    }
+
+    constexpr view_type subview(const index_type& offsets, const index_type& extents) {
+        return view().subview(offsets, extents);
+    }
+
+    constexpr const_view_type subview(const index_type& offsets, const index_type& extents) const {
+        return view().subview(offsets, extents);
+    }
+
+    constexpr view_type subview(const index_type& offsets, const index_type& extents, const index_type& steps) {
+        return view().subview(offsets, extents, steps);
+    }
+
+    constexpr const_view_type subview(const index_type& offsets, const index_type& extents,
+                                      const index_type& steps) const {
+        return view().subview(offsets, extents, steps);
+    }
+
+    constexpr MdView<T, mapping_type, rank - 1> slice(std::size_t dim, std::size_t index) requires(rank > 1) {
+        return view().slice(dim, index);
+    }
+
+    constexpr MdView<const T, mapping_type, rank - 1> slice(std::size_t dim, std::size_t index) const
+        requires(rank > 1) {
+        return view().slice(dim, index);
+    }
+
+    // Visits every element in storage order. Without padding that is a
+    // plain pass over the storage.
+    template <typename F>
+    constexpr void for_each(F&& f) {
+        if constexpr (storage_size() == size()) {
+            for (T& item : m_data) f(item);
+        } else {
+            mapping_type::for_each_index([&](const index_type& idx) { f(m_data[mapping_type::offset(idx)]); });
+        }
+    }
+
+    template <typename F>
+    constexpr void for_each(F&& f) const {
+        if constexpr (storage_size() == size()) {
+            for (const T& item : m_data) f(item);
+        } else {
+            mapping_type::for_each_index([&](const index_type& idx) { f(m_data[mapping_type::offset(idx)]); });
+        }
+    }
+
+    // Same as for_each, but f also receives the index of the element.
+    template <typename F>
+    constexpr void for_each_indexed(F&& f) {
+        mapping_type::for_each_index([&](const index_type& idx) { f(idx, m_data[mapping_type::offset(idx)]); });
+    }
+
+    template <typename F>
+    constexpr void for_each_indexed(F&& f) const {
+        mapping_type::for_each_index([&](const index_type& idx) { f(idx, m_data[mapping_type::offset(idx)]); });
+    }
+
+    // Compares the elements only; the padding of a tiled layout is ignored.
+    constexpr bool operator==(const BasicMdArray& other) const {
+        if constexpr (storage_size() == size()) {
+            return m_data == other.m_data;
+        } else {
+            bool equal = true;
+            mapping_type::for_each_index([&](const index_type& idx) {
+                std::size_t pos = mapping_type::offset(idx);
+                equal = equal && m_data[pos] == other.m_data[pos];
+            });
+            return equal;
+        }
+    }
+
+private:
+    static constexpr index_type ones() noexcept {
+        index_type result{};
+        for (std::size_t& item : result) item = 1;
+        return result;
+    }
+
+    static constexpr index_type dimensions() noexcept {
+        index_type result{};
+        for (std::size_t d = 0; d < rank; ++d) result[d] = d;
+        return result;
+    }
+
+    static constexpr std::size_t checked_offset(const index_type& idx) {
+        for (std::size_t d = 0; d < rank; ++d) {
+            if (idx[d] >= mapping_type::extents[d]) {
+                throw std::out_of_range("Index out of range");
+            }
+        }
+        return mapping_type::offset(idx);
+    }
+};
+
+template <typename T, std::size_t... Extents>
+using MdArray = BasicMdArray<T, RowMajor, Extents...>;
+
+template <typename T, std::size_t... Extents>
+using ColumnMajorMdArray = BasicMdArray<T, ColumnMajor, Extents...>;
+
+template <typename T, std::size_t Tile, std::size_t... Extents>
+using TiledMdArray = BasicMdArray<T, Tiled<Tile>, Extents...>;
+
+#endif //MDARRAY_MDARRAY_HPP
@@ -0,0 +1,155 @@
+#ifndef DEQUE_NODEPOOL_HPP
+#define DEQUE_NODEPOOL_HPP
+
+#include <cstddef>
+#include <new>
+#include <algorithm>
+#include <memory>
+
+// Hands out storage for Node objects from slabs of growing size and recycles
+// freed slots through an intrusive free list. Not thread-safe.
+//
+// Two pools can be merged so that nodes may move between lists that use
+// different pools: the absorbed pool hands its slabs to the surviving pool
+// and forwards all later requests to it.
+template <typename Node>
+class NodePool {
+    union Slot {
+        Slot *next;
+        alignas(Node) unsigned char storage[sizeof(Node)];
+    };
+
+    struct alignas(alignof(Slot)) Slab {
+        Slab *next;
+        std::size_t count;
+
+        Slot *slots() noexcept { return reinterpret_cast<Slot *>(this + 1); }
+    };
+
+    Slab *slabs;
+    Slot *free_list;
+    Slot *free_tail;
+    Slot *bump;
+    Slot *bump_end;
+    std::size_t next_slab;
+    std::size_t max_slab;
+    std::size_t slab_total;
+    std::shared_ptr<NodePool> forward;
+
+    static void free_slab(Slab *slab) noexcept {
+        ::operator delete(slab, std::align_val_t(alignof(Slab)));
+    }
+
+    void add_slab() {
+        std::size_t bytes = sizeof(Slab) + next_slab * sizeof(Slot);
+        auto *slab = static_cast<Slab *>(::operator new(bytes, std::align_val_t(alignof(Slab))));
+        slab->next = slabs;
+        slab->count = next_slab;
+        slabs = slab;
+        bump = slab->slots();
+        bump_end = bump + next_slab;
+        ++slab_total;
+        next_slab = std::min(next_slab * 2, max_slab);
+    }
+
+public:
+    explicit NodePool(std::size_t first_slab = 16, std::size_t largest_slab = 4096)
+            : slabs(nullptr), free_list(nullptr), free_tail(nullptr), bump(nullptr), bump_end(nullptr),
+              next_slab(std::max<std::size_t>(first_slab, 1)),
+              max_slab(std::max(largest_slab, std::max<std::size_t>(first_slab, 1))), slab_total(0) {}
+
+    NodePool(const NodePool &) = delete;
+    NodePool &operator=(const NodePool &) = delete;
+
+    ~NodePool() { release(); }
+
+    void *allocate() {
+        if (forward) return forward->allocate();
+        if (free_list) {
+            Slot *slot = free_list;
+            free_list = slot->next;
+            return slot->storage;
+        }
+        if (bump == bump_end) add_slab();
+        return (bump++)->storage;
+    }
+
+    void deallocate(void *p) noexcept {
+        if (forward) {
+            forward->deallocate(p);
+            return;
+        }
+        auto *slot = reinterpret_cast<Slot *>(p);
+        if (!free_list) free_tail = slot;
+        slot->next = free_list;
+        free_list = slot;
+    }
+
+    bool forwarded() const noexcept { return forward != nullptr; }
+
+    // Follows the forwarding chain to the pool that currently owns the slabs.
+    static std::shared_ptr<NodePool> root(std::shared_ptr<NodePool> p) noexcept {
+        while (p && p->forward) p = p->forward;
+        return p;
+    }
+
+    // Moves the slabs and free slots of from (a root pool) into into (another
+    // root pool) and makes from forward to into. Nodes allocated from either
+    // pool may afterwards be returned to either.
+    static void merge(const std::shared_ptr<NodePool> &into, const std::shared_ptr<NodePool> &from) noexcept {
+        if (into == from) return;
+        if (from->slabs) {
+            Slab *last = from->slabs;
+            while (last->next) last = last->next;
+            last->next = into->slabs;
+            into->slabs = from->slabs;
+            into->slab_total += from->slab_total;
+        }
+        if (from->free_list) {
+            from->free_tail->next = into->free_list;
+            if (!into->free_list) into->free_tail = from->free_tail;
+            into->free_list = from->free_list;
+        }
+        from->slabs = nullptr;
+        from->free_list = from->free_tail = nullptr;
+        from->bump = from->bump_end = nullptr;
+        from->slab_total = 0;
+        from->forward = into;
+    }
+
+    // Drops every outstanding allocation at once, keeping the newest slab
+    // for reuse. All nodes must already have been destroyed.
+    void reset() noexcept {
+        if (!slabs) return;
+        Slab *keep = slabs;
+        for (Slab *slab = keep->next; slab;) {
+            Slab *next = slab->next;
+            free_slab(slab);
+            slab = next;
+        }
+        keep->next = nullptr;
+        slabs = keep;
+        slab_total = 1;
+        free_list = free_tail = nullptr;
+        bump = keep->slots();
+        bump_end = bump + keep->count;
+    }
+
+    // Returns every slab to the system. All nodes must already have been
+    // destroyed.
+    void release() noexcept {
+        for (Slab *slab = slabs; slab;) {
+            Slab *next = slab->next;
+            free_slab(slab);
+            slab = next;
+        }
+        slabs = nullptr;
+        free_list = free_tail = nullptr;
+        bump = bump_end = nullptr;
+        slab_total = 0;
+    }
+
+    std::size_t slab_count() const noexcept { return slab_total; }
+};
+
+#endif //DEQUE_NODEPOOL_HPP
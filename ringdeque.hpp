@@ -0,0 +1,406 @@
+#ifndef DEQUE_RINGDEQUE_HPP
+#define DEQUE_RINGDEQUE_HPP
+
+#include <algorithm>
+#include <bit>
+#include <compare>
+#include <cstddef>
+#include <initializer_list>
+#include <iterator>
+#include <memory>
+#include <stdexcept>
+#include <type_traits>
+#include <utility>
+
+#include "container.hpp"
+
+// Capacity value that selects a RingDeque whose capacity is chosen at
+// construction.
+inline constexpr std::size_t ring_dynamic = 0;
+
+// What a full RingDeque does on push: reject throws std::length_error,
+// overwrite drops the element at the opposite end (the oldest one when
+// pushing at the back).
+enum class RingMode { reject, overwrite };
+
+template <typename T, std::size_t Capacity>
+struct RingStorage {
+    static_assert(std::has_single_bit(Capacity), "RingDeque capacity must be a power of two");
+
+    alignas(T) unsigned char bytes[Capacity * sizeof(T)];
+
+    RingStorage() = default;
+    RingStorage(const RingStorage &) {}
+    RingStorage &operator=(const RingStorage &) { return *this; }
+
+    T *data() noexcept { return std::launder(reinterpret_cast<T *>(bytes)); }
+    const T *data() const noexcept { return std::launder(reinterpret_cast<const T *>(bytes)); }
+    static constexpr std::size_t capacity() noexcept { return Capacity; }
+};
+
+template <typename T>
+struct RingStorage<T, ring_dynamic> {
+    T *ptr = nullptr;
+    std::size_t cap = 0;
+
+    RingStorage() = default;
+    explicit RingStorage(std::size_t capacity)
+            : ptr(capacity ? std::allocator<T>().allocate(std::bit_ceil(capacity)) : nullptr),
+              cap(capacity ? std::bit_ceil(capacity) : 0) {}
+    RingStorage(const RingStorage &other) : RingStorage(other.cap) {}
+    RingStorage &operator=(const RingStorage &) = delete;
+    ~RingStorage() {
+        if (ptr) std::allocator<T>().deallocate(ptr, cap);
+    }
+
+    T *data() noexcept { return ptr; }
+    const T *data() const noexcept { return ptr; }
+    std::size_t capacity() const noexcept { return cap; }
+
+    void swap(RingStorage &other) noexcept {
+        std::swap(ptr, other.ptr);
+        std::swap(cap, other.cap);
+    }
+};
+
+// Double-ended queue in one contiguous power-of-two buffer with mask-based
+// wraparound. RingDeque<T, N> keeps its buffer inline; RingDeque<T> (that
+// is, Capacity == ring_dynamic) allocates it once in the constructor,
+// rounding the requested capacity up to a power of two. Nothing is
+// allocated after construction.
+template <typename T, std::size_t Capacity = ring_dynamic>
+class RingDeque : public Container<T> {
+    static constexpr bool is_dynamic = Capacity == ring_dynamic;
+
+    template <bool Const>
+    class basic_iterator {
+        friend class RingDeque;
+        friend class basic_iterator<!Const>;
+
+        using owner = std::conditional_t<Const, const RingDeque, RingDeque>;
+
+    public:
+        using iterator_category = std::random_access_iterator_tag;
+        using value_type = T;
+        using difference_type = std::ptrdiff_t;
+        using pointer = std::conditional_t<Const, const T*, T*>;
+        using reference = std::conditional_t<Const, const T&, T&>;
+
+        basic_iterator() : ring(nullptr), index(0) {}
+        basic_iterator(owner *r, difference_type i) : ring(r), index(i) {}
+
+        template <bool C = Const, typename = std::enable_if_t<C>>
+        basic_iterator(const basic_iterator<false> &it) : ring(it.ring), index(it.index) {}
+
+        reference operator*() const { return (*ring)[static_cast<std::size_t>(index)]; }
+        pointer operator->() const { return &**this; }
+        reference operator[](difference_type n) const { return *(*this + n); }
+
+        basic_iterator &operator++() {
+            ++index;
+            return *this;
+        }
+
+        basic_iterator operator++(int) {
+            basic_iterator tmp = *this;
+            ++index;
+            return tmp;
+        }
+
+        basic_iterator &operator--() {
+            --index;
+            return *this;
+        }
+
+        basic_iterator operator--(int) {
+            basic_iterator tmp = *this;
+            --index;
+            return tmp;
+        }
+
+        basic_iterator &operator+=(difference_type n) {
+            index += n;
+            return *this;
+        }
+
+        basic_iterator &operator-=(difference_type n) {
+            index -= n;
+            return *this;
+        }
+
+        friend basic_iterator operator+(basic_iterator it, difference_type n) { return it += n; }
+        friend basic_iterator operator+(difference_type n, basic_iterator it) { return it += n; }
+        friend basic_iterator operator-(basic_iterator it, difference_type n) { return it -= n; }
+
+        friend difference_type operator-(const basic_iterator &a, const basic_iterator &b) {
+            return a.index - b.index;
+        }
+
+        friend bool operator==(const basic_iterator &a, const basic_iterator &b) {
+            return a.index == b.index && a.ring == b.ring;
+        }
+
+        friend std::strong_ordering operator<=>(const basic_iterator &a, const basic_iterator &b) {
+            return a.index <=> b.index;
+        }
+
+    private:
+        owner *ring;
+        difference_type index;
+    };
+
+    RingStorage<T, Capacity> storage;
+    std::size_t head = 0;
+    std::size_t count = 0;
+    RingMode mode = RingMode::reject;
+
+    std::size_t mask() const noexcept { return storage.capacity() - 1; }
+    T *slot(std::size_t i) noexcept { return storage.data() + ((head + i) & mask()); }
+    const T *slot(std::size_t i) const noexcept { return storage.data() + ((head + i) & mask()); }
+
+public:
+    using iterator = basic_iterator<false>;
+    using const_iterator = basic_iterator<true>;
+
+    explicit RingDeque(RingMode ring_mode = RingMode::reject) requires (!is_dynamic)
+            : mode(ring_mode) {}
+
+    explicit RingDeque(std::size_t capacity, RingMode ring_mode = RingMode::reject) requires is_dynamic
+            : storage(capacity), mode(ring_mode) {}
+
+    RingDeque(std::initializer_list<T> init) requires (!is_dynamic) {
+        try {
+            for (const T &item : init) push_back(item);
+        } catch (...) {
+            clear();
+            throw;
+        }
+    }
+
+    RingDeque(const RingDeque &other) : Container<T>(), storage(other.storage), mode(other.mode) {
+        try {
+            for (const T &item : other) push_back(item);
+        } catch (...) {
+            clear();
+            throw;
+        }
+    }
+
+    RingDeque(RingDeque &&other) noexcept(is_dynamic || std::is_nothrow_move_constructible_v<T>)
+            : mode(other.mode) {
+        if constexpr (is_dynamic) {
+            storage.swap(other.storage);
+            head = std::exchange(other.head, 0);
+            count = std::exchange(other.count, 0);
+        } else {
+            auto take = [&] {
+                for (; count < other.count; ++count) {
+                    ::new (static_cast<void *>(storage.data() + count)) T(std::move(other[count]));
+                }
+            };
+            if constexpr (std::is_nothrow_move_constructible_v<T>) {
+                take();
+            } else {
+                try {
+                    take();
+                } catch (...) {
+                    clear();
+                    throw;
+                }
+            }
+            other.clear();
+        }
+    }
+
+    ~RingDeque() override { clear(); }
+
+    Container<T>& operator=(const Container<T>& other) override {
+        if (this != &other) {
+            auto* ring = dynamic_cast<const RingDeque*>(&other);
+            if (!ring) {
+                throw std::invalid_argument("Assigned Container must be of type RingDeque");
+            }
+            *this = *ring;
+        }
+        return *this;
+    }
+
+    RingDeque &operator=(const RingDeque &other) {
+        if (this != &other) {
+            if constexpr (is_dynamic) {
+                RingDeque tmp(other);
+                swap(tmp);
+            } else {
+                clear();
+                mode = other.mode;
+                for (const T &item : other) push_back(item);
+            }
+        }
+        return *this;
+    }
+
+    RingDeque &operator=(RingDeque &&other) noexcept(is_dynamic || std::is_nothrow_move_constructible_v<T>) {
+        if (this != &other) {
+            clear();
+            if constexpr (is_dynamic) {
+                swap(other);
+            } else {
+                mode = other.mode;
+                for (T &item : other) push_back(std::move(item));
+                other.clear();
+            }
+        }
+        return *this;
+    }
+
+    T &operator[](std::size_t pos) noexcept { return *slot(pos); }
+    const T &operator[](std::size_t pos) const noexcept { return *slot(pos); }
+
+    T &at(std::size_t pos) {
+        if (pos >= count) throw std::out_of_range("Index out of range");
+        return *slot(pos);
+    }
+
+    const T &at(std::size_t pos) const {
+        if (pos >= count) throw std::out_of_range("Index out of range");
+        return *slot(pos);
+    }
+
+    T &front() {
+        if (count == 0) throw std::out_of_range("Deque is empty");
+        return *slot(0);
+    }
+
+    const T &front() const {
+        if (count == 0) throw std::out_of_range("Deque is empty");
+        return *slot(0);
+    }
+
+    T &back() {
+        if (count == 0) throw std::out_of_range("Deque is empty");
+        return *slot(count - 1);
+    }
+
+    const T &back() const {
+        if (count == 0) throw std::out_of_range("Deque is empty");
+        return *slot(count - 1);
+    }
+
+    iterator begin() noexcept { return iterator(this, 0); }
+    iterator end() noexcept { return iterator(this, static_cast<std::ptrdiff_t>(count)); }
+    const_iterator begin() const noexcept { return const_iterator(this, 0); }
+    const_iterator end() const noexcept { return const_iterator(this, static_cast<std::ptrdiff_t>(count)); }
+    const_iterator cbegin() const noexcept { return begin(); }
+    const_iterator cend() const noexcept { return end(); }
+
+    bool empty() const noexcept override { return count == 0; }
+    bool full() const noexcept { return count == storage.capacity(); }
+    std::size_t size() const noexcept override { return count; }
+    std::size_t max_size() const noexcept override { return storage.capacity(); }
+    std::size_t capacity() const noexcept { return storage.capacity(); }
+
+    RingMode overflow_mode() const noexcept { return mode; }
+    void set_overflow_mode(RingMode ring_mode) noexcept { mode = ring_mode; }
+
+    // In overwrite mode the new element is built before the oldest one is
+    // dropped, so args may refer to an element of this deque.
+    template <typename... Args>
+    T &emplace_back(Args &&...args) {
+        if (full() && mode == RingMode::overwrite && count > 0) {
+            T value(std::forward<Args>(args)...);
+            pop_front();
+            return emplace_back(std::move(value));
+        }
+        if (full()) throw std::length_error("RingDeque is full");
+        T *p = ::new (static_cast<void *>(slot(count))) T(std::forward<Args>(args)...);
+        ++count;
+        return *p;
+    }
+
+    template <typename... Args>
+    T &emplace_front(Args &&...args) {
+        if (full() && mode == RingMode::overwrite && count > 0) {
+            T value(std::forward<Args>(args)...);
+            pop_back();
+            return emplace_front(std::move(value));
+        }
+        if (full()) throw std::length_error("RingDeque is full");
+        std::size_t new_head = (head - 1) & mask();
+        T *p = ::new (static_cast<void *>(storage.data() + new_head)) T(std::forward<Args>(args)...);
+        head = new_head;
+        ++count;
+        return *p;
+    }
+
+    void push_back(const T &value) { emplace_back(value); }
+    void push_back(T &&value) { emplace_back(std::move(value)); }
+    void push_front(const T &value) { emplace_front(value); }
+    void push_front(T &&value) { emplace_front(std::move(value)); }
+
+    // Non-throwing pushes for reject mode; false when the deque is full.
+    bool try_push_back(const T &value) {
+        if (full()) return false;
+        emplace_back(value);
+        return true;
+    }
+
+    bool try_push_front(const T &value) {
+        if (full()) return false;
+        emplace_front(value);
+        return true;
+    }
+
+    void pop_back() noexcept {
+        if (count == 0) return;
+        --count;
+        std::destroy_at(slot(count));
+    }
+
+    void pop_front() noexcept {
+        if (count == 0) return;
+        std::destroy_at(slot(0));
+        head = (head + 1) & mask();
+        --count;
+    }
+
+    void clear() noexcept {
+        if constexpr (!std::is_trivially_destructible_v<T>) {
+            for (std::size_t i = 0; i < count; ++i) std::destroy_at(slot(i));
+        }
+        head = 0;
+        count = 0;
+    }
+
+    void swap(RingDeque &other) noexcept requires is_dynamic {
+        storage.swap(other.storage);
+        std::swap(head, other.head);
+        std::swap(count, other.count);
+        std::swap(mode, other.mode);
+    }
+
+    bool operator==(const RingDeque &other) const {
+        return count == other.count && std::equal(begin(), end(), other.begin());
+    }
+
+    bool operator==(const Container<T>& other) const override {
+        auto* ring = dynamic_cast<const RingDeque*>(&other);
+        return ring && *this == *ring;
+    }
+
+    bool operator!=(const Container<T>& other) const override {
+        return !(*this == other);
+    }
+
+    std::strong_ordering operator<=>(const RingDeque &other) const {
+        std::size_t n = std::min(count, other.count);
+        for (std::size_t i = 0; i < n; ++i) {
+            if (auto cmp = (*this)[i] <=> other[i]; cmp != 0) return cmp;
+        }
+        return count <=> other.count;
+    }
+};
+
+template <typename T>
+using DynamicRingDeque = RingDeque<T, ring_dynamic>;
+
+#endif //DEQUE_RINGDEQUE_HPP
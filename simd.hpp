@@ -0,0 +1,466 @@
+#ifndef SIMD_SIMD_HPP
+#define SIMD_SIMD_HPP
+
+#include <cstddef>
+#include <cstdint>
+#include <compare>
+#include <type_traits>
+
+#if !defined(MY_CONTAINER_NO_SIMD) && (defined(__x86_64__) || defined(__i386__)) && \
+    (defined(__GNUC__) || defined(__clang__))
+#define MY_CONTAINER_SIMD_X86 1
+#define MY_CONTAINER_AVX2 __attribute__((target("avx2")))
+#include <immintrin.h>
+#endif
+
+// Fill, copy, search and comparison kernels over contiguous arrays of
+// arithmetic values.
+// On x86 the AVX2 versions are picked at run time when the CPU supports them;
+// everything else uses the scalar loops. Define MY_CONTAINER_NO_SIMD to force
+// the scalar path.
+namespace my_container::simd {
+
+    template <typename T>
+    concept vectorizable = (std::is_integral_v<T> && !std::is_same_v<T, bool>) ||
+                           std::is_same_v<T, float> || std::is_same_v<T, double>;
+
+    inline bool has_avx2() noexcept {
+#ifdef MY_CONTAINER_SIMD_X86
+        static const bool supported = [] {
+            __builtin_cpu_init();
+            return __builtin_cpu_supports("avx2") != 0;
+        }();
+        return supported;
+#else
+        return false;
+#endif
+    }
+
+    // Fills and copies of at least this many bytes use non-temporal stores:
+    // a buffer that large would only evict the working set from the cache.
+    inline constexpr std::size_t streaming_threshold = std::size_t{1} << 20;
+
+    namespace detail {
+
+        template <typename T>
+        void fill_scalar(T* a, std::size_t n, T value) {
+            for (std::size_t i = 0; i < n; ++i) a[i] = value;
+        }
+
+        template <typename T>
+        void copy_scalar(T* dst, const T* src, std::size_t n) {
+            for (std::size_t i = 0; i < n; ++i) dst[i] = src[i];
+        }
+
+        template <typename T>
+        void swap_scalar(T* a, T* b, std::size_t n) {
+            for (std::size_t i = 0; i < n; ++i) {
+                T tmp = a[i];
+                a[i] = b[i];
+                b[i] = tmp;
+            }
+        }
+
+        template <typename T>
+        std::size_t mismatch_scalar(const T* a, const T* b, std::size_t n) {
+            std::size_t i = 0;
+            while (i < n && a[i] == b[i]) ++i;
+            return i;
+        }
+
+        template <typename T>
+        std::size_t find_scalar(const T* a, std::size_t n, T value) {
+            std::size_t i = 0;
+            while (i < n && !(a[i] == value)) ++i;
+            return i;
+        }
+
+        template <typename T>
+        std::size_t count_scalar(const T* a, std::size_t n, T value) {
+            std::size_t result = 0;
+            for (std::size_t i = 0; i < n; ++i) result += a[i] == value;
+            return result;
+        }
+
+        template <typename T>
+        T min_scalar(const T* a, std::size_t n, T init) {
+            for (std::size_t i = 0; i < n; ++i) {
+                if (a[i] < init) init = a[i];
+            }
+            return init;
+        }
+
+        template <typename T>
+        T max_scalar(const T* a, std::size_t n, T init) {
+            for (std::size_t i = 0; i < n; ++i) {
+                if (init < a[i]) init = a[i];
+            }
+            return init;
+        }
+
+        template <typename T>
+        T sum_scalar(const T* a, std::size_t n, T init) {
+            if constexpr (std::is_integral_v<T> && std::is_signed_v<T>) {
+                // Signed overflow is undefined; add in the unsigned type so the
+                // sum wraps the way the vector lanes do.
+                using U = std::make_unsigned_t<T>;
+                U acc = static_cast<U>(init);
+                for (std::size_t i = 0; i < n; ++i) acc = static_cast<U>(acc + static_cast<U>(a[i]));
+                return static_cast<T>(acc);
+            } else {
+                for (std::size_t i = 0; i < n; ++i) init = static_cast<T>(init + a[i]);
+                return init;
+            }
+        }
+
+#ifdef MY_CONTAINER_SIMD_X86
+        template <typename T, typename = void>
+        struct avx2_ops;
+
+        // Integer lanes: comparison masks come from movemask_epi8, so every
+        // lane contributes sizeof(T) bits.
+        template <typename T>
+        struct avx2_ops<T, std::enable_if_t<std::is_integral_v<T>>> {
+            using vec = __m256i;
+            static constexpr std::size_t width = 32 / sizeof(T);
+            static constexpr unsigned lane_bits = sizeof(T);
+            static constexpr unsigned full_mask = 0xFFFFFFFFu;
+
+            MY_CONTAINER_AVX2 static vec load(const T* p) {
+                return _mm256_loadu_si256(reinterpret_cast<const __m256i*>(p));
+            }
+
+            MY_CONTAINER_AVX2 static void store(T* p, vec v) {
+                _mm256_storeu_si256(reinterpret_cast<__m256i*>(p), v);
+            }
+
+            MY_CONTAINER_AVX2 static vec set1(T v) {
+                if constexpr (sizeof(T) == 1) return _mm256_set1_epi8(static_cast<char>(v));
+                else if constexpr (sizeof(T) == 2) return _mm256_set1_epi16(static_cast<short>(v));
+                else if constexpr (sizeof(T) == 4) return _mm256_set1_epi32(static_cast<int>(v));
+                else return _mm256_set1_epi64x(static_cast<long long>(v));
+            }
+
+            MY_CONTAINER_AVX2 static vec cmpeq(vec a, vec b) {
+                if constexpr (sizeof(T) == 1) return _mm256_cmpeq_epi8(a, b);
+                else if constexpr (sizeof(T) == 2) return _mm256_cmpeq_epi16(a, b);
+                else if constexpr (sizeof(T) == 4) return _mm256_cmpeq_epi32(a, b);
+                else return _mm256_cmpeq_epi64(a, b);
+            }
+
+            MY_CONTAINER_AVX2 static unsigned eq_mask(vec a, vec b) {
+                return static_cast<unsigned>(_mm256_movemask_epi8(cmpeq(a, b)));
+            }
+
+            // a > b for 64-bit lanes, signed or unsigned.
+            MY_CONTAINER_AVX2 static vec cmpgt64(vec a, vec b) {
+                if constexpr (std::is_unsigned_v<T>) {
+                    const vec bias = _mm256_set1_epi64x(static_cast<long long>(0x8000000000000000ull));
+                    return _mm256_cmpgt_epi64(_mm256_xor_si256(a, bias), _mm256_xor_si256(b, bias));
+                } else {
+                    return _mm256_cmpgt_epi64(a, b);
+                }
+            }
+
+            MY_CONTAINER_AVX2 static vec min(vec a, vec b) {
+                if constexpr (sizeof(T) == 1) return std::is_signed_v<T> ? _mm256_min_epi8(a, b) : _mm256_min_epu8(a, b);
+                else if constexpr (sizeof(T) == 2) return std::is_signed_v<T> ? _mm256_min_epi16(a, b) : _mm256_min_epu16(a, b);
+                else if constexpr (sizeof(T) == 4) return std::is_signed_v<T> ? _mm256_min_epi32(a, b) : _mm256_min_epu32(a, b);
+                else return _mm256_blendv_epi8(a, b, cmpgt64(a, b));
+            }
+
+            MY_CONTAINER_AVX2 static vec max(vec a, vec b) {
+                if constexpr (sizeof(T) == 1) return std::is_signed_v<T> ? _mm256_max_epi8(a, b) : _mm256_max_epu8(a, b);
+                else if constexpr (sizeof(T) == 2) return std::is_signed_v<T> ? _mm256_max_epi16(a, b) : _mm256_max_epu16(a, b);
+                else if constexpr (sizeof(T) == 4) return std::is_signed_v<T> ? _mm256_max_epi32(a, b) : _mm256_max_epu32(a, b);
+                else return _mm256_blendv_epi8(b, a, cmpgt64(a, b));
+            }
+
+            MY_CONTAINER_AVX2 static vec add(vec a, vec b) {
+                if constexpr (sizeof(T) == 1) return _mm256_add_epi8(a, b);
+                else if constexpr (sizeof(T) == 2) return _mm256_add_epi16(a, b);
+                else if constexpr (sizeof(T) == 4) return _mm256_add_epi32(a, b);
+                else return _mm256_add_epi64(a, b);
+            }
+        };
+
+        template <>
+        struct avx2_ops<float> {
+            using vec = __m256;
+            static constexpr std::size_t width = 8;
+            static constexpr unsigned lane_bits = 1;
+            static constexpr unsigned full_mask = 0xFFu;
+
+            MY_CONTAINER_AVX2 static vec load(const float* p) { return _mm256_loadu_ps(p); }
+            MY_CONTAINER_AVX2 static void store(float* p, vec v) { _mm256_storeu_ps(p, v); }
+            MY_CONTAINER_AVX2 static vec set1(float v) { return _mm256_set1_ps(v); }
+            MY_CONTAINER_AVX2 static unsigned eq_mask(vec a, vec b) {
+                return static_cast<unsigned>(_mm256_movemask_ps(_mm256_cmp_ps(a, b, _CMP_EQ_OQ)));
+            }
+            MY_CONTAINER_AVX2 static vec min(vec a, vec b) { return _mm256_min_ps(a, b); }
+            MY_CONTAINER_AVX2 static vec max(vec a, vec b) { return _mm256_max_ps(a, b); }
+            MY_CONTAINER_AVX2 static vec add(vec a, vec b) { return _mm256_add_ps(a, b); }
+        };
+
+        template <>
+        struct avx2_ops<double> {
+            using vec = __m256d;
+            static constexpr std::size_t width = 4;
+            static constexpr unsigned lane_bits = 1;
+            static constexpr unsigned full_mask = 0xFu;
+
+            MY_CONTAINER_AVX2 static vec load(const double* p) { return _mm256_loadu_pd(p); }
+            MY_CONTAINER_AVX2 static void store(double* p, vec v) { _mm256_storeu_pd(p, v); }
+            MY_CONTAINER_AVX2 static vec set1(double v) { return _mm256_set1_pd(v); }
+            MY_CONTAINER_AVX2 static unsigned eq_mask(vec a, vec b) {
+                return static_cast<unsigned>(_mm256_movemask_pd(_mm256_cmp_pd(a, b, _CMP_EQ_OQ)));
+            }
+            MY_CONTAINER_AVX2 static vec min(vec a, vec b) { return _mm256_min_pd(a, b); }
+            MY_CONTAINER_AVX2 static vec max(vec a, vec b) { return _mm256_max_pd(a, b); }
+            MY_CONTAINER_AVX2 static vec add(vec a, vec b) { return _mm256_add_pd(a, b); }
+        };
+
+        // Number of leading elements to skip so that dst + head is 32-byte
+        // aligned, as streaming stores require, or n when dst can never be.
+        template <typename T>
+        std::size_t stream_head(const T* dst, std::size_t n) noexcept {
+            auto address = reinterpret_cast<std::uintptr_t>(dst);
+            if (address % sizeof(T) != 0) return n;
+            std::size_t head = (32 - address % 32) % 32 / sizeof(T);
+            return head < n ? head : n;
+        }
+
+        // Fill, copy and swap move raw bits, so one set of 256-bit integer
+        // loads and stores serves every element type.
+        template <typename T>
+        MY_CONTAINER_AVX2 void fill_avx2(T* a, std::size_t n, T value) {
+            constexpr std::size_t width = 32 / sizeof(T);
+            T lanes[width];
+            fill_scalar(lanes, width, value);
+            const __m256i pattern = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(lanes));
+            std::size_t i = 0;
+            if (n * sizeof(T) >= streaming_threshold) {
+                i = stream_head(a, n);
+                fill_scalar(a, i, value);
+                for (; i + width <= n; i += width) _mm256_stream_si256(reinterpret_cast<__m256i*>(a + i), pattern);
+                _mm_sfence();
+            } else {
+                for (; i + width <= n; i += width) _mm256_storeu_si256(reinterpret_cast<__m256i*>(a + i), pattern);
+            }
+            fill_scalar(a + i, n - i, value);
+        }
+
+        template <typename T>
+        MY_CONTAINER_AVX2 void copy_avx2(T* dst, const T* src, std::size_t n) {
+            constexpr std::size_t width = 32 / sizeof(T);
+            std::size_t i = 0;
+            if (n * sizeof(T) >= streaming_threshold) {
+                i = stream_head(dst, n);
+                copy_scalar(dst, src, i);
+                for (; i + width <= n; i += width) {
+                    __m256i v = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(src + i));
+                    _mm256_stream_si256(reinterpret_cast<__m256i*>(dst + i), v);
+                }
+                _mm_sfence();
+            } else {
+                for (; i + width <= n; i += width) {
+                    __m256i v = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(src + i));
+                    _mm256_storeu_si256(reinterpret_cast<__m256i*>(dst + i), v);
+                }
+            }
+            copy_scalar(dst + i, src + i, n - i);
+        }
+
+        template <typename T>
+        MY_CONTAINER_AVX2 void swap_avx2(T* a, T* b, std::size_t n) {
+            constexpr std::size_t width = 32 / sizeof(T);
+            std::size_t i = 0;
+            for (; i + width <= n; i += width) {
+                __m256i va = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(a + i));
+                __m256i vb = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(b + i));
+                _mm256_storeu_si256(reinterpret_cast<__m256i*>(a + i), vb);
+                _mm256_storeu_si256(reinterpret_cast<__m256i*>(b + i), va);
+            }
+            swap_scalar(a + i, b + i, n - i);
+        }
+
+        template <typename T>
+        MY_CONTAINER_AVX2 std::size_t mismatch_avx2(const T* a, const T* b, std::size_t n) {
+            using ops = avx2_ops<T>;
+            std::size_t i = 0;
+            for (; i + ops::width <= n; i += ops::width) {
+                unsigned mask = ops::eq_mask(ops::load(a + i), ops::load(b + i));
+                if (mask != ops::full_mask) {
+                    return i + static_cast<std::size_t>(__builtin_ctz(~mask & ops::full_mask)) / ops::lane_bits;
+                }
+            }
+            return i + mismatch_scalar(a + i, b + i, n - i);
+        }
+
+        template <typename T>
+        MY_CONTAINER_AVX2 std::size_t find_avx2(const T* a, std::size_t n, T value) {
+            using ops = avx2_ops<T>;
+            const typename ops::vec needle = ops::set1(value);
+            std::size_t i = 0;
+            for (; i + ops::width <= n; i += ops::width) {
+                unsigned mask = ops::eq_mask(ops::load(a + i), needle);
+                if (mask != 0) {
+                    return i + static_cast<std::size_t>(__builtin_ctz(mask)) / ops::lane_bits;
+                }
+            }
+            return i + find_scalar(a + i, n - i, value);
+        }
+
+        template <typename T>
+        MY_CONTAINER_AVX2 std::size_t count_avx2(const T* a, std::size_t n, T value) {
+            using ops = avx2_ops<T>;
+            const typename ops::vec needle = ops::set1(value);
+            std::size_t bits = 0;
+            std::size_t i = 0;
+            for (; i + ops::width <= n; i += ops::width) {
+                bits += static_cast<std::size_t>(__builtin_popcount(ops::eq_mask(ops::load(a + i), needle)));
+            }
+            return bits / ops::lane_bits + count_scalar(a + i, n - i, value);
+        }
+
+        // Requires n >= width.
+        template <typename T>
+        MY_CONTAINER_AVX2 T min_avx2(const T* a, std::size_t n) {
+            using ops = avx2_ops<T>;
+            typename ops::vec acc = ops::load(a);
+            std::size_t i = ops::width;
+            for (; i + ops::width <= n; i += ops::width) acc = ops::min(ops::load(a + i), acc);
+            T lanes[ops::width];
+            ops::store(lanes, acc);
+            return min_scalar(a + i, n - i, min_scalar(lanes + 1, ops::width - 1, lanes[0]));
+        }
+
+        template <typename T>
+        MY_CONTAINER_AVX2 T max_avx2(const T* a, std::size_t n) {
+            using ops = avx2_ops<T>;
+            typename ops::vec acc = ops::load(a);
+            std::size_t i = ops::width;
+            for (; i + ops::width <= n; i += ops::width) acc = ops::max(ops::load(a + i), acc);
+            T lanes[ops::width];
+            ops::store(lanes, acc);
+            return max_scalar(a + i, n - i, max_scalar(lanes + 1, ops::width - 1, lanes[0]));
+        }
+
+        template <typename T>
+        MY_CONTAINER_AVX2 T sum_avx2(const T* a, std::size_t n) {
+            using ops = avx2_ops<T>;
+            typename ops::vec acc = ops::set1(T{});
+            std::size_t i = 0;
+            for (; i + ops::width <= n; i += ops::width) acc = ops::add(acc, ops::load(a + i));
+            T lanes[ops::width];
+            ops::store(lanes, acc);
+            return sum_scalar(a + i, n - i, sum_scalar(lanes, ops::width, T{}));
+        }
+
+        template <typename T>
+        bool use_avx2(std::size_t n) noexcept {
+            return n >= avx2_ops<T>::width && has_avx2();
+        }
+#endif
+
+    }  // namespace detail
+
+    template <vectorizable T>
+    void fill(T* a, std::size_t n, T value) {
+#ifdef MY_CONTAINER_SIMD_X86
+        if (detail::use_avx2<T>(n)) return detail::fill_avx2(a, n, value);
+#endif
+        detail::fill_scalar(a, n, value);
+    }
+
+    // The ranges must not overlap.
+    template <vectorizable T>
+    void copy(T* dst, const T* src, std::size_t n) {
+#ifdef MY_CONTAINER_SIMD_X86
+        if (detail::use_avx2<T>(n)) return detail::copy_avx2(dst, src, n);
+#endif
+        detail::copy_scalar(dst, src, n);
+    }
+
+    // The ranges must not overlap.
+    template <vectorizable T>
+    void swap_ranges(T* a, T* b, std::size_t n) {
+#ifdef MY_CONTAINER_SIMD_X86
+        if (detail::use_avx2<T>(n)) return detail::swap_avx2(a, b, n);
+#endif
+        detail::swap_scalar(a, b, n);
+    }
+
+    // Index of the first position where a and b differ, or n.
+    template <vectorizable T>
+    std::size_t mismatch(const T* a, const T* b, std::size_t n) {
+#ifdef MY_CONTAINER_SIMD_X86
+        if (detail::use_avx2<T>(n)) return detail::mismatch_avx2(a, b, n);
+#endif
+        return detail::mismatch_scalar(a, b, n);
+    }
+
+    template <vectorizable T>
+    bool equal(const T* a, const T* b, std::size_t n) {
+        return mismatch(a, b, n) == n;
+    }
+
+    // Lexicographic three-way comparison of [a, a + na) and [b, b + nb).
+    template <vectorizable T>
+    std::compare_three_way_result_t<T> compare_three_way(const T* a, std::size_t na,
+                                                         const T* b, std::size_t nb) {
+        std::size_t common = na < nb ? na : nb;
+        std::size_t i = mismatch(a, b, common);
+        if (i < common) return a[i] <=> b[i];
+        return na <=> nb;
+    }
+
+    // Index of the first element equal to value, or n.
+    template <vectorizable T>
+    std::size_t find(const T* a, std::size_t n, T value) {
+#ifdef MY_CONTAINER_SIMD_X86
+        if (detail::use_avx2<T>(n)) return detail::find_avx2(a, n, value);
+#endif
+        return detail::find_scalar(a, n, value);
+    }
+
+    template <vectorizable T>
+    std::size_t count(const T* a, std::size_t n, T value) {
+#ifdef MY_CONTAINER_SIMD_X86
+        if (detail::use_avx2<T>(n)) return detail::count_avx2(a, n, value);
+#endif
+        return detail::count_scalar(a, n, value);
+    }
+
+    // Requires n > 0.
+    template <vectorizable T>
+    T min(const T* a, std::size_t n) {
+#ifdef MY_CONTAINER_SIMD_X86
+        if (detail::use_avx2<T>(n)) return detail::min_avx2(a, n);
+#endif
+        return detail::min_scalar(a + 1, n - 1, a[0]);
+    }
+
+    // Requires n > 0.
+    template <vectorizable T>
+    T max(const T* a, std::size_t n) {
+#ifdef MY_CONTAINER_SIMD_X86
+        if (detail::use_avx2<T>(n)) return detail::max_avx2(a, n);
+#endif
+        return detail::max_scalar(a + 1, n - 1, a[0]);
+    }
+
+    // Integer sums wrap modulo 2^bits of the element type, signed or not,
+    // on both the scalar and vector paths; floating-point sums are
+    // accumulated per lane, so rounding may differ from a sequential loop.
+    template <vectorizable T>
+    T sum(const T* a, std::size_t n) {
+#ifdef MY_CONTAINER_SIMD_X86
+        if (detail::use_avx2<T>(n)) return detail::sum_avx2(a, n);
+#endif
+        return detail::sum_scalar(a, n, T{});
+    }
+
+}  // namespace my_container::simd
+
+#endif //SIMD_SIMD_HPP
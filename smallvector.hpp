@@ -0,0 +1,18 @@
+#ifndef SMALLVECTOR_SMALLVECTOR_HPP
+#define SMALLVECTOR_SMALLVECTOR_HPP
+
+#include "vector.hpp"
+
+namespace my_container {
+
+    // Vector with room for N elements inside the object itself. Storage moves
+    // to the heap only when the size exceeds the inline capacity. It is a
+    // Vector with an inline buffer, so it shares Vector's whole interface and
+    // implementation.
+    template <typename T, std::size_t N, typename Allocator = std::allocator<T>, typename GrowthPolicy = GrowDouble,
+              typename StatsHook = NoVectorStats>
+    using SmallVector = Vector<T, Allocator, GrowthPolicy, StatsHook, N>;
+
+}  // namespace my_container
+
+#endif //SMALLVECTOR_SMALLVECTOR_HPP
@@ -5,116 +5,224 @@
 #ifndef STACK_STACK_HPP
 #define STACK_STACK_HPP
 
-#include "deque.hpp"
-
-template <typename T>
-class Stack final: public Deque<T> {
-    Deque<T> data;
+#include <algorithm>
+#include <compare>
+#include <initializer_list>
+#include <iterator>
+#include <ranges>
+#include <stdexcept>
+#include <utility>
+
+#include "container.hpp"
+#include "vector.hpp"
+
+// LIFO adaptor over a sequence container. The top of the stack is the back
+// of Backing, so the default contiguous Vector pushes and pops without
+// allocating once its capacity is reached. Backing needs back(),
+// emplace_back(), pop_back() and bidirectional iterators.
+template <typename T, typename Backing = my_container::Vector<T>>
+class Stack final : public Container<T> {
+    Backing data;
 public:
-    Stack();
-    Stack(const Stack<T>& other);
-    Stack(Stack<T> &&other) noexcept;
+    using container_type = Backing;
+
+    Stack() = default;
+    explicit Stack(const Backing& backing);
+    explicit Stack(Backing&& backing) noexcept(std::is_nothrow_move_constructible_v<Backing>);
+    Stack(const Stack& other);
+    Stack(Stack&& other) noexcept(std::is_nothrow_move_constructible_v<Backing>);
+    // Elements are listed from the top of the stack down.
     Stack(std::initializer_list<T> init);
 
-    ~Stack() = default;
+    ~Stack() override = default;
 
-    Stack<T> & operator=(const Stack<T> & other);
-    Stack<T> & operator=(Stack<T> && other) noexcept;
+    Container<T>& operator=(const Container<T>& other) override;
+    Stack& operator=(const Stack& other);
+    Stack& operator=(Stack&& other) noexcept(std::is_nothrow_move_assignable_v<Backing>);
 
     T& top();
     const T& top() const;
 
-    size_t size() const noexcept;
-    bool empty() const noexcept;
+    std::size_t size() const noexcept override;
+    std::size_t max_size() const noexcept override;
+    bool empty() const noexcept override;
+
+    void push(const T& value);
+    void push(T&& value);
+    template <typename... Args>
+    T& emplace(Args&&... args);
+    // Pushes the elements of range in order, so its last element ends up on top.
+    template <std::ranges::input_range R>
+    void push_range(R&& range);
 
-    void push(const T& val);
-    void push(T&& val);
     void pop();
-    void swap(Stack<T> & other);
+    // Removes the top count elements.
+    void pop_n(std::size_t count);
+
+    void swap(Stack& other) noexcept(std::is_nothrow_swappable_v<Backing>);
+
+    const Backing& container() const noexcept { return data; }
+
+    bool operator==(const Stack& other) const;
+    // Compares lexicographically from the top of the stack down.
+    auto operator<=>(const Stack& other) const;
 
-    bool operator==(Stack<T> other) const;
-    std::strong_ordering operator<=>(Stack<T> other) const;
+    bool operator==(const Container<T>& other) const override;
+    bool operator!=(const Container<T>& other) const override;
 };
 
-    template <typename T>
-    Stack<T> :: Stack(): data{} {};
+    template <typename T, typename Backing>
+    Stack<T, Backing>::Stack(const Backing& backing): data(backing) {}
 
-    template <typename T>
-    Stack<T>::Stack(const Stack<T> &other)
-            : Deque<T>(other), data(other.data) {}
+    template <typename T, typename Backing>
+    Stack<T, Backing>::Stack(Backing&& backing) noexcept(std::is_nothrow_move_constructible_v<Backing>)
+            : data(std::move(backing)) {}
 
-    template <typename T>
-    Stack<T> ::Stack(Stack<T> &&other) noexcept: data(std::move(other.data)) {};
+    template <typename T, typename Backing>
+    Stack<T, Backing>::Stack(const Stack& other): Container<T>(), data(other.data) {}
 
-    template <typename T>
-    Stack<T>::Stack(std::initializer_list<T> init): data{init} {};
+    template <typename T, typename Backing>
+    Stack<T, Backing>::Stack(Stack&& other) noexcept(std::is_nothrow_move_constructible_v<Backing>)
+            : data(std::move(other.data)) {}
 
-    template<typename T>
-    Stack<T> &Stack<T>::operator=(const Stack<T> &other) {
-        if (*this != other) {
+    template <typename T, typename Backing>
+    Stack<T, Backing>::Stack(std::initializer_list<T> init) {
+        push_range(std::ranges::subrange(std::rbegin(init), std::rend(init)));
+    }
+
+    template <typename T, typename Backing>
+    Container<T>& Stack<T, Backing>::operator=(const Container<T>& other) {
+        if (this != &other) {
+            auto* stack = dynamic_cast<const Stack*>(&other);
+            if (!stack) {
+                throw std::invalid_argument("Assigned Container must be of type Stack");
+            }
+            *this = *stack;
+        }
+        return *this;
+    }
+
+    template <typename T, typename Backing>
+    Stack<T, Backing>& Stack<T, Backing>::operator=(const Stack& other) {
+        if (this != &other) {
             data = other.data;
         }
         return *this;
     }
 
-    template<typename T>
-    Stack<T> &Stack<T>::operator=(Stack<T> &&other) noexcept {
-        if (*this != other)  {
+    template <typename T, typename Backing>
+    Stack<T, Backing>& Stack<T, Backing>::operator=(Stack&& other)
+            noexcept(std::is_nothrow_move_assignable_v<Backing>) {
+        if (this != &other) {
             data = std::move(other.data);
         }
         return *this;
     }
 
-    template<typename T>
-    T &Stack<T>::top() {
-        return data.front();
+    template <typename T, typename Backing>
+    T& Stack<T, Backing>::top() {
+        if (empty()) {
+            throw std::out_of_range("Stack is empty");
+        }
+        return data.back();
     }
 
-    template<typename T>
-    const T& Stack<T>::top() const {
-        return data.front();
+    template <typename T, typename Backing>
+    const T& Stack<T, Backing>::top() const {
+        if (empty()) {
+            throw std::out_of_range("Stack is empty");
+        }
+        return data.back();
     }
 
-    template<typename T>
-    size_t Stack<T>::size() const noexcept{
+    template <typename T, typename Backing>
+    std::size_t Stack<T, Backing>::size() const noexcept {
         return data.size();
     }
 
-    template<typename T>
-    bool Stack<T>::empty() const noexcept{
+    template <typename T, typename Backing>
+    std::size_t Stack<T, Backing>::max_size() const noexcept {
+        return data.max_size();
+    }
+
+    template <typename T, typename Backing>
+    bool Stack<T, Backing>::empty() const noexcept {
         return data.empty();
     }
 
-    template<typename T>
-    void Stack<T>::push(const T &value) {
-        data.push_front(value);
+    template <typename T, typename Backing>
+    void Stack<T, Backing>::push(const T& value) {
+        data.emplace_back(value);
+    }
+
+    template <typename T, typename Backing>
+    void Stack<T, Backing>::push(T&& value) {
+        data.emplace_back(std::move(value));
     }
 
-    template<typename T>
-    void Stack<T>::push(T &&value) {
-        data.push_front(value);
+    template <typename T, typename Backing>
+    template <typename... Args>
+    T& Stack<T, Backing>::emplace(Args&&... args) {
+        data.emplace_back(std::forward<Args>(args)...);
+        return data.back();
     }
 
-    template<typename T>
-    void Stack<T>::pop() {
+    template <typename T, typename Backing>
+    template <std::ranges::input_range R>
+    void Stack<T, Backing>::push_range(R&& range) {
+        if constexpr (requires { data.append_range(std::forward<R>(range)); }) {
+            data.append_range(std::forward<R>(range));
+        } else {
+            for (auto&& item : range) data.emplace_back(std::forward<decltype(item)>(item));
+        }
+    }
+
+    template <typename T, typename Backing>
+    void Stack<T, Backing>::pop() {
         if (empty()) {
             throw std::out_of_range("Stack is empty");
         }
-        data.pop_front();
+        data.pop_back();
+    }
+
+    template <typename T, typename Backing>
+    void Stack<T, Backing>::pop_n(std::size_t count) {
+        if (count > size()) {
+            throw std::out_of_range("Stack is empty");
+        }
+        if constexpr (requires(std::size_t i) { data.erase(i, i); }) {
+            data.erase(size() - count, size());
+        } else {
+            while (count--) data.pop_back();
+        }
+    }
+
+    template <typename T, typename Backing>
+    void Stack<T, Backing>::swap(Stack& other) noexcept(std::is_nothrow_swappable_v<Backing>) {
+        using std::swap;
+        swap(data, other.data);
+    }
+
+    template <typename T, typename Backing>
+    bool Stack<T, Backing>::operator==(const Stack& other) const {
+        return size() == other.size() && std::equal(std::begin(data), std::end(data), std::begin(other.data));
     }
 
-    template<typename T>
-    bool Stack<T>::operator==(const Stack<T> other) const {
-        return (*this <=> other) == std::strong_ordering::equal;
+    template <typename T, typename Backing>
+    auto Stack<T, Backing>::operator<=>(const Stack& other) const {
+        return std::lexicographical_compare_three_way(
+                std::make_reverse_iterator(std::end(data)), std::make_reverse_iterator(std::begin(data)),
+                std::make_reverse_iterator(std::end(other.data)), std::make_reverse_iterator(std::begin(other.data)));
     }
 
-    template<typename T>
-    std::strong_ordering Stack<T>::operator<=>(const Stack<T> other) const {
-        return data <=> other.data;
+    template <typename T, typename Backing>
+    bool Stack<T, Backing>::operator==(const Container<T>& other) const {
+        auto* stack = dynamic_cast<const Stack*>(&other);
+        return stack && *this == *stack;
     }
 
-    template<typename T>
-    void Stack<T>::swap(Stack<T> &other) {
-        data.swap(other.data);
+    template <typename T, typename Backing>
+    bool Stack<T, Backing>::operator!=(const Container<T>& other) const {
+        return !(*this == other);
     }
 #endif //STACK_STACK_HPP
@@ -0,0 +1,91 @@
+// Checks that List::sort and List::merge keep every node linked when the
+// comparator throws part way through.
+//
+//   g++ -std=c++20 -I.. listtest.cpp && ./a.out
+
+#include <algorithm>
+#include <cassert>
+#include <cstddef>
+#include <cstdio>
+#include <iterator>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+#include "../list.hpp"
+
+namespace {
+
+    // Compares strings and throws on the throw_at-th call.
+    struct ThrowingLess {
+        std::size_t* calls;
+        std::size_t throw_at;
+
+        bool operator()(const std::string& a, const std::string& b) const {
+            if (++*calls == throw_at) throw std::runtime_error("comparison failed");
+            return a < b;
+        }
+    };
+
+    std::vector<std::string> sorted_items(const List<std::string>& list) {
+        std::vector<std::string> items(list.begin(), list.end());
+        std::sort(items.begin(), items.end());
+        return items;
+    }
+
+    // size() matches the nodes reachable from begin(), back() is the last of
+    // them, and no element was lost or duplicated.
+    void check_intact(const List<std::string>& list, const std::vector<std::string>& expected) {
+        assert(list.size() == static_cast<std::size_t>(std::distance(list.begin(), list.end())));
+        const std::string* last = nullptr;
+        for (const std::string& item : list) last = &item;
+        assert(list.empty() || &list.back() == last);
+        assert(sorted_items(list) == expected);
+    }
+
+    List<std::string> make_list(std::size_t count, std::size_t seed) {
+        List<std::string> list;
+        for (std::size_t i = 0; i < count; ++i) list.push_back("item" + std::to_string((i * 7919 + seed) % 1000));
+        return list;
+    }
+
+}  // namespace
+
+int main() {
+    for (std::size_t throw_at : {1, 2, 50, 150, 400, 600}) {
+        List<std::string> list = make_list(100, throw_at);
+        std::vector<std::string> expected = sorted_items(list);
+        std::size_t calls = 0;
+        try {
+            list.sort(ThrowingLess{&calls, throw_at});
+        } catch (const std::runtime_error&) {
+        }
+        check_intact(list, expected);
+        list.sort();
+        assert(std::is_sorted(list.begin(), list.end()));
+        list.pop_back();
+        list.pop_front();
+    }
+
+    for (std::size_t throw_at : {1, 10, 60, 120}) {
+        List<std::string> a = make_list(60, 1);
+        List<std::string> b = make_list(70, 2);
+        a.sort();
+        b.sort();
+        std::vector<std::string> expected(a.begin(), a.end());
+        expected.insert(expected.end(), b.begin(), b.end());
+        std::sort(expected.begin(), expected.end());
+        std::size_t calls = 0;
+        try {
+            a.merge(b, ThrowingLess{&calls, throw_at});
+        } catch (const std::runtime_error&) {
+        }
+        check_intact(a, expected);
+        assert(b.empty() && b.begin() == b.end());
+        b.push_back("again");
+        assert(b.size() == 1);
+    }
+
+    std::puts("ok");
+    return 0;
+}
@@ -0,0 +1,81 @@
+// Checks that MdView::for_each visits elements in storage order for every
+// layout, including sub-blocks, strided views and slices of a tiled array
+// whose edges do not line up with the tiles.
+//
+//   g++ -std=c++20 -I.. mdarraytest.cpp && ./a.out
+
+#include <cassert>
+#include <cstddef>
+#include <cstdio>
+#include <vector>
+
+#include "../mdarray.hpp"
+
+namespace {
+
+    // Offsets of the elements of view in the order for_each visits them.
+    template <typename View, typename T>
+    std::vector<std::ptrdiff_t> visited(const View& view, const T* data) {
+        std::vector<std::ptrdiff_t> offsets;
+        view.for_each([&](const T& item) { offsets.push_back(&item - data); });
+        return offsets;
+    }
+
+    bool increasing(const std::vector<std::ptrdiff_t>& offsets) {
+        for (std::size_t i = 1; i < offsets.size(); ++i) {
+            if (offsets[i - 1] >= offsets[i]) return false;
+        }
+        return true;
+    }
+
+    template <typename A>
+    void check_views(const A& array) {
+        const auto* data = array.data();
+        auto full = array.view();
+        assert(visited(full, data).size() == A::size() && increasing(visited(full, data)));
+
+        auto block = array.subview({1, 2, 3}, {5, 4, 3});
+        assert(visited(block, data).size() == 60 && increasing(visited(block, data)));
+
+        auto strided = array.subview({0, 1, 1}, {4, 3, 3}, {2, 2, 3});
+        assert(visited(strided, data).size() == 36 && increasing(visited(strided, data)));
+
+        auto slice = array.slice(1, 4);
+        assert(visited(slice, data).size() == 7 * 11 && increasing(visited(slice, data)));
+
+        auto column = array.slice(0, 3).slice(1, 2);
+        assert(visited(column, data).size() == 6 && increasing(visited(column, data)));
+
+        // for_each_indexed hands out the index of the element it visits.
+        std::size_t count = 0;
+        block.for_each_indexed([&](const MdIndex<3>& idx, const auto& item) {
+            assert(&item == &block[idx]);
+            ++count;
+        });
+        assert(count == 60);
+    }
+
+}  // namespace
+
+int main() {
+    check_views(MdArray<int, 7, 6, 11>{});
+    check_views(ColumnMajorMdArray<int, 7, 6, 11>{});
+    check_views(TiledMdArray<int, 4, 7, 6, 11>{});
+    check_views(TiledMdArray<int, 3, 7, 6, 11>{});
+
+    // A 4 x 4 view of a 2 x 2 tiled array: the four elements of each tile
+    // come before the next tile.
+    TiledMdArray<int, 2, 4, 4> tiled{};
+    const int* data = tiled.data();
+    std::vector<std::ptrdiff_t> expected(16);
+    for (std::size_t i = 0; i < expected.size(); ++i) expected[i] = static_cast<std::ptrdiff_t>(i);
+    assert(visited(tiled.view(), data) == expected);
+
+    std::vector<MdIndex<2>> order;
+    tiled.view().for_each_indexed([&](const MdIndex<2>& idx, const int&) { order.push_back(idx); });
+    assert((order[0] == MdIndex<2>{0, 0} && order[1] == MdIndex<2>{0, 1} && order[2] == MdIndex<2>{1, 0} &&
+            order[3] == MdIndex<2>{1, 1} && order[4] == MdIndex<2>{0, 2}));
+
+    std::puts("ok");
+    return 0;
+}
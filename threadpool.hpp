@@ -0,0 +1,363 @@
+#ifndef THREADPOOL_THREADPOOL_HPP
+#define THREADPOOL_THREADPOOL_HPP
+
+#include <cstddef>
+#include <cstdint>
+#include <algorithm>
+#include <atomic>
+#include <condition_variable>
+#include <deque>
+#include <exception>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <thread>
+#include <utility>
+#include <vector>
+
+#include "workstealingdeque.hpp"
+
+namespace my_container {
+
+    inline constexpr std::size_t cache_line_size = 64;
+
+    // Work-stealing thread pool. Every worker owns a Chase-Lev deque: tasks
+    // submitted from a worker go to the bottom of its own deque and are run
+    // newest first, while idle workers steal the oldest tasks of a random
+    // victim. Tasks submitted from other threads go through a shared
+    // injection queue.
+    class ThreadPool {
+    public:
+        explicit ThreadPool(std::size_t threads = default_thread_count()) {
+            threads = std::max<std::size_t>(threads, 1);
+            workers_.reserve(threads);
+            for (std::size_t i = 0; i < threads; ++i) workers_.push_back(std::make_unique<Worker>());
+            try {
+                for (std::size_t i = 0; i < threads; ++i) {
+                    workers_[i]->thread = std::thread([this, i] { worker_loop(i); });
+                }
+            } catch (...) {
+                shutdown();
+                throw;
+            }
+        }
+
+        ThreadPool(const ThreadPool&) = delete;
+        ThreadPool& operator=(const ThreadPool&) = delete;
+
+        ~ThreadPool() {
+            shutdown();
+        }
+
+        static std::size_t default_thread_count() noexcept {
+            return std::max(1u, std::thread::hardware_concurrency());
+        }
+
+        // Process-wide pool used when no pool is given explicitly.
+        static ThreadPool& shared() {
+            static ThreadPool pool;
+            return pool;
+        }
+
+        std::size_t size() const noexcept {
+            return workers_.size();
+        }
+
+        template <typename F>
+        void submit(F&& task) {
+            auto owned = std::make_unique<Task>(std::forward<F>(task));
+            pending_.fetch_add(1, std::memory_order_relaxed);
+            queued_.fetch_add(1, std::memory_order_seq_cst);
+            if (context_.pool == this) {
+                workers_[context_.index]->tasks.push(owned.get());
+            } else {
+                std::lock_guard<std::mutex> lock(injection_mutex_);
+                injection_.push_back(owned.get());
+                injected_.store(injection_.size(), std::memory_order_release);
+            }
+            owned.release();
+            if (sleepers_.load(std::memory_order_seq_cst) > 0) {
+                { std::lock_guard<std::mutex> lock(mutex_); }
+                work_cv_.notify_one();
+                idle_cv_.notify_all();
+            }
+        }
+
+        // Blocks until every submitted task has finished, then rethrows the
+        // first exception thrown by any of them. The calling thread runs
+        // queued tasks while it waits. Called from inside a task, it does not
+        // wait for that task itself, nor for other tasks that are blocked in
+        // wait() as well, since none of them can finish first.
+        void wait() {
+            std::size_t self = context_.pool == this ? context_.index : no_worker;
+            std::uint64_t rng = reinterpret_cast<std::uintptr_t>(&self) | 1;
+            bool in_task = false;
+            for (Frame* frame = frame_; frame && !in_task; frame = frame->outer) in_task = frame->pool == this;
+            if (in_task) {
+                waiting_.fetch_add(1, std::memory_order_seq_cst);
+                { std::lock_guard<std::mutex> lock(mutex_); }
+                idle_cv_.notify_all();
+            }
+            while (!settled(in_task)) {
+                if (Task* task = find_task(self, rng)) {
+                    run(task);
+                    continue;
+                }
+                // Tasks submitted meanwhile wake this thread too, since every
+                // worker may be blocked here.
+                std::unique_lock<std::mutex> lock(mutex_);
+                sleepers_.fetch_add(1, std::memory_order_seq_cst);
+                idle_cv_.wait(lock, [this, in_task] {
+                    return settled(in_task) || queued_.load(std::memory_order_seq_cst) > 0;
+                });
+                sleepers_.fetch_sub(1, std::memory_order_relaxed);
+            }
+            if (in_task) waiting_.fetch_sub(1, std::memory_order_seq_cst);
+            std::lock_guard<std::mutex> lock(mutex_);
+            if (error_) {
+                std::exception_ptr error = std::exchange(error_, nullptr);
+                std::rethrow_exception(error);
+            }
+        }
+
+        // Runs body(i) for every i in [0, count). The calling thread takes part,
+        // so this is safe to call from inside a pool task. Rethrows the first
+        // exception after all indices have been processed.
+        template <typename F>
+        void parallel_for(std::size_t count, F&& body) {
+            if (count == 0) return;
+            if (count == 1 || size() == 1) {
+                for (std::size_t i = 0; i < count; ++i) body(i);
+                return;
+            }
+            struct State {
+                std::atomic<std::size_t> next{0};
+                std::atomic<std::size_t> done{0};
+                std::mutex error_mutex;
+                std::exception_ptr error;
+            };
+            auto state = std::make_shared<State>();
+            auto* fn = &body;
+            auto drain = [state, fn, count] {
+                std::size_t i;
+                while ((i = state->next.fetch_add(1, std::memory_order_relaxed)) < count) {
+                    try {
+                        (*fn)(i);
+                    } catch (...) {
+                        std::lock_guard<std::mutex> lock(state->error_mutex);
+                        if (!state->error) state->error = std::current_exception();
+                    }
+                    if (state->done.fetch_add(1, std::memory_order_acq_rel) + 1 == count) {
+                        state->done.notify_all();
+                    }
+                }
+            };
+            std::size_t helpers = std::min(count - 1, size());
+            for (std::size_t h = 0; h < helpers; ++h) submit(drain);
+            drain();
+            std::size_t done;
+            while ((done = state->done.load(std::memory_order_acquire)) != count) {
+                state->done.wait(done, std::memory_order_acquire);
+            }
+            if (state->error) std::rethrow_exception(state->error);
+        }
+
+    private:
+        using Task = std::function<void()>;
+
+        static constexpr std::size_t no_worker = static_cast<std::size_t>(-1);
+
+        struct alignas(cache_line_size) Worker {
+            WorkStealingDeque<Task*> tasks;
+            std::thread thread;
+        };
+
+        struct Context {
+            ThreadPool* pool;
+            std::size_t index;
+        };
+
+        // One per task running on the calling thread, innermost first.
+        struct Frame {
+            ThreadPool* pool;
+            Frame* outer;
+        };
+
+        // Whether wait() may return: every task has finished or, for a wait()
+        // from inside a task, every unfinished task is blocked in wait().
+        bool settled(bool in_task) const noexcept {
+            std::size_t pending = pending_.load(std::memory_order_seq_cst);
+            return pending == 0 || (in_task && pending <= waiting_.load(std::memory_order_seq_cst));
+        }
+
+        static std::uint64_t next_random(std::uint64_t& state) noexcept {
+            state ^= state << 13;
+            state ^= state >> 7;
+            state ^= state << 17;
+            return state;
+        }
+
+        // Own deque first, then the injection queue, then random victims.
+        Task* find_task(std::size_t self, std::uint64_t& rng) {
+            std::optional<Task*> task;
+            if (self != no_worker) task = workers_[self]->tasks.pop();
+            if (!task && injected_.load(std::memory_order_acquire) != 0) {
+                std::lock_guard<std::mutex> lock(injection_mutex_);
+                if (!injection_.empty()) {
+                    task = injection_.front();
+                    injection_.pop_front();
+                    injected_.store(injection_.size(), std::memory_order_release);
+                }
+            }
+            if (!task) {
+                std::size_t n = workers_.size();
+                std::size_t first = static_cast<std::size_t>(next_random(rng) % n);
+                for (std::size_t i = 0; i < n && !task; ++i) {
+                    std::size_t victim = (first + i) % n;
+                    if (victim != self) task = workers_[victim]->tasks.steal();
+                }
+            }
+            if (!task) return nullptr;
+            queued_.fetch_sub(1, std::memory_order_relaxed);
+            return *task;
+        }
+
+        void run(Task* task) {
+            std::unique_ptr<Task> owned(task);
+            Frame frame{this, frame_};
+            frame_ = &frame;
+            try {
+                (*owned)();
+            } catch (...) {
+                std::lock_guard<std::mutex> lock(mutex_);
+                if (!error_) error_ = std::current_exception();
+            }
+            frame_ = frame.outer;
+            owned.reset();
+            std::size_t left = pending_.fetch_sub(1, std::memory_order_seq_cst) - 1;
+            if (left <= waiting_.load(std::memory_order_seq_cst)) {
+                { std::lock_guard<std::mutex> lock(mutex_); }
+                idle_cv_.notify_all();
+            }
+        }
+
+        void worker_loop(std::size_t index) {
+            context_ = Context{this, index};
+            std::uint64_t rng = (index + 1) * 0x9E3779B97F4A7C15ull;
+            for (;;) {
+                if (Task* task = find_task(index, rng)) {
+                    run(task);
+                    continue;
+                }
+                std::unique_lock<std::mutex> lock(mutex_);
+                sleepers_.fetch_add(1, std::memory_order_seq_cst);
+                work_cv_.wait(lock, [this] { return stopping_ || queued_.load(std::memory_order_seq_cst) > 0; });
+                sleepers_.fetch_sub(1, std::memory_order_relaxed);
+                if (stopping_ && queued_.load(std::memory_order_seq_cst) <= 0) return;
+            }
+        }
+
+        // Lets the workers finish every queued task, then joins them.
+        void shutdown() noexcept {
+            {
+                std::lock_guard<std::mutex> lock(mutex_);
+                stopping_ = true;
+            }
+            work_cv_.notify_all();
+            for (auto& worker : workers_) {
+                if (worker->thread.joinable()) worker->thread.join();
+            }
+        }
+
+        static inline thread_local Context context_{nullptr, 0};
+        static inline thread_local Frame* frame_ = nullptr;
+
+        std::vector<std::unique_ptr<Worker>> workers_;
+        std::mutex injection_mutex_;
+        std::deque<Task*> injection_;
+        std::atomic<std::size_t> injected_{0};
+        // Tasks submitted but not yet taken by a thread; may dip below zero
+        // for a moment while a submission is in flight.
+        alignas(cache_line_size) std::atomic<std::ptrdiff_t> queued_{0};
+        // Tasks submitted but not yet finished.
+        alignas(cache_line_size) std::atomic<std::size_t> pending_{0};
+        // Tasks blocked in wait().
+        std::atomic<std::size_t> waiting_{0};
+        std::atomic<std::size_t> sleepers_{0};
+        std::mutex mutex_;
+        std::condition_variable work_cv_;
+        std::condition_variable idle_cv_;
+        std::exception_ptr error_;
+        bool stopping_ = false;
+    };
+
+    struct ParallelOptions {
+        // Elements per task; 0 picks about four tasks per worker.
+        std::size_t chunk_size = 0;
+        // Inputs shorter than this run on the calling thread only.
+        std::size_t serial_threshold = std::size_t{1} << 16;
+        // Pool to run on; nullptr means ThreadPool::shared().
+        ThreadPool* pool = nullptr;
+    };
+
+    // Splits [base, base + count) into chunks whose boundaries fall on cache
+    // line boundaries (when sizeof(T) divides the line size), so no two tasks
+    // write to the same line.
+    class ChunkPlan {
+    public:
+        template <typename T>
+        ChunkPlan(const T* base, std::size_t count, const ParallelOptions& options) : count_(count) {
+            if (count == 0) return;
+            pool_ = options.pool ? options.pool : &ThreadPool::shared();
+            if (count < options.serial_threshold || pool_->size() == 1) {
+                chunk_ = count;
+                tasks_ = 1;
+                return;
+            }
+            constexpr std::size_t line = cache_line_size % sizeof(T) == 0 ? cache_line_size / sizeof(T) : 1;
+            std::size_t chunk = options.chunk_size ? options.chunk_size
+                                                   : std::max<std::size_t>(count / (pool_->size() * 4), 1);
+            chunk_ = (chunk + line - 1) / line * line;
+            if (line > 1) {
+                auto misalignment = reinterpret_cast<std::uintptr_t>(base) % cache_line_size;
+                std::size_t head_bytes = (cache_line_size - misalignment) % cache_line_size;
+                head_ = head_bytes % sizeof(T) == 0 ? std::min(head_bytes / sizeof(T), count) : 0;
+            }
+            tasks_ = count <= head_ ? 1 : (count - head_ + chunk_ - 1) / chunk_;
+        }
+
+        std::size_t tasks() const noexcept {
+            return tasks_;
+        }
+
+        std::size_t begin(std::size_t task) const noexcept {
+            return task == 0 ? 0 : std::min(head_ + task * chunk_, count_);
+        }
+
+        std::size_t end(std::size_t task) const noexcept {
+            return task + 1 == tasks_ ? count_ : begin(task + 1);
+        }
+
+        // Calls body(task, first, last) for every chunk.
+        template <typename F>
+        void run(F&& body) const {
+            if (tasks_ == 0) return;
+            if (tasks_ == 1) {
+                body(std::size_t{0}, std::size_t{0}, count_);
+                return;
+            }
+            pool_->parallel_for(tasks_, [&](std::size_t task) { body(task, begin(task), end(task)); });
+        }
+
+    private:
+        ThreadPool* pool_ = nullptr;
+        std::size_t count_;
+        std::size_t chunk_ = 0;
+        std::size_t head_ = 0;
+        std::size_t tasks_ = 0;
+    };
+
+}  // namespace my_container
+
+#endif //THREADPOOL_THREADPOOL_HPP
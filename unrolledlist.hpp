@@ -0,0 +1,685 @@
+#ifndef DEQUE_UNROLLEDLIST_HPP
+#define DEQUE_UNROLLEDLIST_HPP
+
+#include <algorithm>
+#include <compare>
+#include <cstddef>
+#include <functional>
+#include <initializer_list>
+#include <iterator>
+#include <limits>
+#include <memory>
+#include <new>
+#include <stdexcept>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+#include "container.hpp"
+
+// Elements per chunk so that a chunk of small elements fills one cache line;
+// larger elements get at least four per chunk.
+template <typename T>
+constexpr std::size_t unrolled_chunk_size() {
+    constexpr std::size_t line = 64;
+    constexpr std::size_t header = 2 * sizeof(void *) + sizeof(std::size_t);
+    return header + 4 * sizeof(T) <= line ? (line - header) / sizeof(T) : 4;
+}
+
+// Doubly linked list of chunks holding up to ChunkSize elements each. A full
+// chunk splits when an element is inserted into it, and sparse neighbouring
+// chunks merge on erase. Inserting or erasing invalidates iterators into the
+// chunks involved and end(); references to other elements stay valid.
+template <typename T, std::size_t ChunkSize = unrolled_chunk_size<T>()>
+class UnrolledList : public Container<T> {
+    static_assert(ChunkSize > 0, "UnrolledList needs at least one element per chunk");
+
+    struct alignas(std::max<std::size_t>(64, alignof(T))) Chunk {
+        Chunk *prev;
+        Chunk *next;
+        std::size_t count;
+        alignas(T) unsigned char storage[ChunkSize * sizeof(T)];
+
+        T *items() noexcept { return std::launder(reinterpret_cast<T *>(storage)); }
+        const T *items() const noexcept { return std::launder(reinterpret_cast<const T *>(storage)); }
+    };
+
+    Chunk *head;
+    Chunk *tail;
+    std::size_t list_size;
+
+    static Chunk *make_chunk() {
+        Chunk *c = new Chunk;
+        c->prev = c->next = nullptr;
+        c->count = 0;
+        return c;
+    }
+
+    // Links c in front of next; a null next means the back.
+    void link_chunk(Chunk *c, Chunk *next) noexcept {
+        Chunk *prev = next ? next->prev : tail;
+        c->prev = prev;
+        c->next = next;
+        if (prev) prev->next = c;
+        else head = c;
+        if (next) next->prev = c;
+        else tail = c;
+    }
+
+    // Unlinks and frees an empty chunk.
+    void free_chunk(Chunk *c) noexcept {
+        if (c->prev) c->prev->next = c->next;
+        else head = c->next;
+        if (c->next) c->next->prev = c->prev;
+        else tail = c->prev;
+        delete c;
+    }
+
+    // Returns a new unlinked chunk holding one element built from args.
+    template <typename... Args>
+    static Chunk *make_chunk_with(Args &&...args) {
+        Chunk *c = make_chunk();
+        try {
+            ::new (static_cast<void *>(c->items())) T(std::forward<Args>(args)...);
+        } catch (...) {
+            delete c;
+            throw;
+        }
+        c->count = 1;
+        return c;
+    }
+
+    // Moves the elements from index at onwards into a new chunk after c.
+    void split(Chunk *c, std::size_t at) {
+        Chunk *n = make_chunk();
+        try {
+            std::uninitialized_move(c->items() + at, c->items() + c->count, n->items());
+        } catch (...) {
+            delete n;
+            throw;
+        }
+        std::destroy(c->items() + at, c->items() + c->count);
+        n->count = c->count - at;
+        c->count = at;
+        link_chunk(n, c->next);
+    }
+
+    // Appends the elements of c->next to c and frees c->next.
+    void merge_next(Chunk *c) noexcept {
+        Chunk *n = c->next;
+        std::uninitialized_move(n->items(), n->items() + n->count, c->items() + c->count);
+        std::destroy(n->items(), n->items() + n->count);
+        c->count += n->count;
+        n->count = 0;
+        free_chunk(n);
+    }
+
+    // Inserts value at index i of a chunk that has room for it.
+    static void shift_insert(Chunk *c, std::size_t i, T &&value) {
+        T *items = c->items();
+        if (i == c->count) {
+            ::new (static_cast<void *>(items + i)) T(std::move(value));
+            ++c->count;
+            return;
+        }
+        ::new (static_cast<void *>(items + c->count)) T(std::move(items[c->count - 1]));
+        ++c->count;
+        std::move_backward(items + i, items + c->count - 2, items + c->count - 1);
+        items[i] = std::move(value);
+    }
+
+    // Finds the element at address pos, or the end of the list when pos is
+    // one past the last element.
+    bool locate(const T *pos, const Chunk *&chunk, std::size_t &index) const {
+        std::less<const T *> before;
+        for (const Chunk *c = head; c; c = c->next) {
+            const T *items = c->items();
+            if (!before(pos, items) && before(pos, items + c->count)) {
+                chunk = c;
+                index = static_cast<std::size_t>(pos - items);
+                return true;
+            }
+        }
+        if (tail && pos == tail->items() + tail->count) {
+            chunk = tail;
+            index = tail->count;
+            return true;
+        }
+        return false;
+    }
+
+    void destroy_chunks() noexcept {
+        for (Chunk *c = head; c;) {
+            Chunk *next = c->next;
+            std::destroy(c->items(), c->items() + c->count);
+            delete c;
+            c = next;
+        }
+        head = tail = nullptr;
+        list_size = 0;
+    }
+
+public:
+    class const_iterator;
+
+    class iterator {
+        friend class UnrolledList;
+        friend class const_iterator;
+
+    public:
+        using iterator_category = std::bidirectional_iterator_tag;
+        using value_type = T;
+        using difference_type = std::ptrdiff_t;
+        using pointer = T*;
+        using reference = T&;
+
+        iterator() : chunk(nullptr), index(0) {}
+        iterator(Chunk *c, std::size_t i) : chunk(c), index(i) {}
+
+        reference operator*() const { return chunk->items()[index]; }
+        pointer operator->() const { return chunk->items() + index; }
+
+        iterator &operator++() {
+            if (++index == chunk->count && chunk->next) {
+                chunk = chunk->next;
+                index = 0;
+            }
+            return *this;
+        }
+
+        iterator operator++(int) {
+            iterator tmp = *this;
+            ++(*this);
+            return tmp;
+        }
+
+        iterator &operator--() {
+            if (index == 0) {
+                chunk = chunk->prev;
+                index = chunk->count;
+            }
+            --index;
+            return *this;
+        }
+
+        iterator operator--(int) {
+            iterator tmp = *this;
+            --(*this);
+            return tmp;
+        }
+
+        friend bool operator==(const iterator &a, const iterator &b) {
+            return a.chunk == b.chunk && a.index == b.index;
+        }
+
+        friend bool operator!=(const iterator &a, const iterator &b) {
+            return !(a == b);
+        }
+
+    private:
+        Chunk *chunk;
+        std::size_t index;
+    };
+
+    class const_iterator {
+        friend class UnrolledList;
+
+    public:
+        using iterator_category = std::bidirectional_iterator_tag;
+        using value_type = T;
+        using difference_type = std::ptrdiff_t;
+        using pointer = const T*;
+        using reference = const T&;
+
+        const_iterator() : chunk(nullptr), index(0) {}
+        const_iterator(const Chunk *c, std::size_t i) : chunk(c), index(i) {}
+        const_iterator(const iterator &it) : chunk(it.chunk), index(it.index) {}
+
+        reference operator*() const { return chunk->items()[index]; }
+        pointer operator->() const { return chunk->items() + index; }
+
+        const_iterator &operator++() {
+            if (++index == chunk->count && chunk->next) {
+                chunk = chunk->next;
+                index = 0;
+            }
+            return *this;
+        }
+
+        const_iterator operator++(int) {
+            const_iterator tmp = *this;
+            ++(*this);
+            return tmp;
+        }
+
+        const_iterator &operator--() {
+            if (index == 0) {
+                chunk = chunk->prev;
+                index = chunk->count;
+            }
+            --index;
+            return *this;
+        }
+
+        const_iterator operator--(int) {
+            const_iterator tmp = *this;
+            --(*this);
+            return tmp;
+        }
+
+        friend bool operator==(const const_iterator &a, const const_iterator &b) {
+            return a.chunk == b.chunk && a.index == b.index;
+        }
+
+        friend bool operator!=(const const_iterator &a, const const_iterator &b) {
+            return !(a == b);
+        }
+
+    private:
+        iterator unconst() const { return iterator(const_cast<Chunk *>(chunk), index); }
+
+        const Chunk *chunk;
+        std::size_t index;
+    };
+
+private:
+    // Whether b can be reached from a by incrementing.
+    bool precedes(const_iterator a, const_iterator b) const {
+        for (const_iterator e = end(); a != e; ++a) {
+            if (a == b) return true;
+        }
+        return b == end();
+    }
+
+public:
+    UnrolledList() : head(nullptr), tail(nullptr), list_size(0) {}
+
+    UnrolledList(const UnrolledList &other) : UnrolledList() {
+        try {
+            for (const T &item : other) push_back(item);
+        } catch (...) {
+            destroy_chunks();
+            throw;
+        }
+    }
+
+    UnrolledList(UnrolledList &&other) noexcept
+            : head(other.head), tail(other.tail), list_size(other.list_size) {
+        other.head = other.tail = nullptr;
+        other.list_size = 0;
+    }
+
+    UnrolledList(std::initializer_list<T> init) : UnrolledList() {
+        try {
+            for (const T &item : init) push_back(item);
+        } catch (...) {
+            destroy_chunks();
+            throw;
+        }
+    }
+
+    ~UnrolledList() override { destroy_chunks(); }
+
+    Container<T>& operator=(const Container<T>& other) override {
+        if (this != &other) {
+            auto* lst = dynamic_cast<const UnrolledList*>(&other);
+            if (!lst) {
+                throw std::invalid_argument("Assigned Container must be of type UnrolledList");
+            }
+            *this = *lst;
+        }
+        return *this;
+    }
+
+    UnrolledList &operator=(const UnrolledList &other) {
+        if (this != &other) {
+            UnrolledList tmp(other);
+            swap(tmp);
+        }
+        return *this;
+    }
+
+    UnrolledList &operator=(UnrolledList &&other) noexcept {
+        if (this != &other) {
+            destroy_chunks();
+            swap(other);
+        }
+        return *this;
+    }
+
+    bool empty() const noexcept override { return list_size == 0; }
+    std::size_t size() const noexcept override { return list_size; }
+    std::size_t max_size() const noexcept override { return std::numeric_limits<std::size_t>::max(); }
+
+    static constexpr std::size_t chunk_size() noexcept { return ChunkSize; }
+
+    iterator begin() noexcept { return iterator(head, 0); }
+    iterator end() noexcept { return iterator(tail, tail ? tail->count : 0); }
+
+    const_iterator begin() const noexcept { return const_iterator(head, 0); }
+    const_iterator end() const noexcept { return const_iterator(tail, tail ? tail->count : 0); }
+
+    const_iterator cbegin() const noexcept { return begin(); }
+    const_iterator cend() const noexcept { return end(); }
+
+    T &front() {
+        if (!head) throw std::out_of_range("List is empty");
+        return head->items()[0];
+    }
+
+    const T &front() const {
+        if (!head) throw std::out_of_range("List is empty");
+        return head->items()[0];
+    }
+
+    T &back() {
+        if (!tail) throw std::out_of_range("List is empty");
+        return tail->items()[tail->count - 1];
+    }
+
+    const T &back() const {
+        if (!tail) throw std::out_of_range("List is empty");
+        return tail->items()[tail->count - 1];
+    }
+
+    template <typename... Args>
+    iterator emplace(const_iterator pos, Args &&...args) {
+        Chunk *c = const_cast<Chunk *>(pos.chunk);
+        std::size_t i = pos.index;
+        if (!c) {
+            c = make_chunk_with(std::forward<Args>(args)...);
+            link_chunk(c, nullptr);
+            ++list_size;
+            return iterator(c, 0);
+        }
+        // Prefer spare room at the end of the previous chunk over shifting.
+        if (i == 0 && c->prev && c->prev->count < ChunkSize) {
+            c = c->prev;
+            i = c->count;
+        }
+        if (i == c->count && i < ChunkSize) {
+            ::new (static_cast<void *>(c->items() + i)) T(std::forward<Args>(args)...);
+            ++c->count;
+            ++list_size;
+            return iterator(c, i);
+        }
+        T value(std::forward<Args>(args)...);
+        if (c->count == ChunkSize) {
+            if (i == 0 || i == ChunkSize) {
+                Chunk *n = make_chunk_with(std::move(value));
+                link_chunk(n, i == 0 ? c : c->next);
+                ++list_size;
+                return iterator(n, 0);
+            }
+            split(c, ChunkSize / 2);
+            if (i > c->count) {
+                i -= c->count;
+                c = c->next;
+            }
+        }
+        shift_insert(c, i, std::move(value));
+        ++list_size;
+        return iterator(c, i);
+    }
+
+    iterator insert(const_iterator pos, const T &value) {
+        return emplace(pos, value);
+    }
+
+    iterator insert(const_iterator pos, T &&value) {
+        return emplace(pos, std::move(value));
+    }
+
+    iterator erase(const_iterator pos) {
+        Chunk *c = const_cast<Chunk *>(pos.chunk);
+        std::size_t i = pos.index;
+        T *items = c->items();
+        std::move(items + i + 1, items + c->count, items + i);
+        std::destroy_at(items + --c->count);
+        --list_size;
+        if (c->count == 0) {
+            Chunk *next = c->next;
+            free_chunk(c);
+            return next ? iterator(next, 0) : end();
+        }
+        if constexpr (std::is_nothrow_move_constructible_v<T>) {
+            if (c->count < ChunkSize / 2) {
+                if (c->next && c->count + c->next->count <= ChunkSize) {
+                    merge_next(c);
+                } else if (c->prev && c->prev->count + c->count <= ChunkSize) {
+                    i += c->prev->count;
+                    c = c->prev;
+                    merge_next(c);
+                }
+            }
+        }
+        if (i == c->count && c->next) return iterator(c->next, 0);
+        return iterator(c, i);
+    }
+
+    iterator erase(const_iterator first, const_iterator last) {
+        std::size_t count = 0;
+        for (const_iterator it = first; it != last; ++it) ++count;
+        iterator it(const_cast<Chunk *>(first.chunk), first.index);
+        while (count--) it = erase(it);
+        return it;
+    }
+
+    // Pointer-based modifiers find the chunk holding pos by walking the
+    // chunks. A null pos inserts at the front, one past the last element at
+    // the back. They return nullptr when pos is not an element of the list.
+    T *insert(const T *pos, const T &value) {
+        if (!pos) return &*emplace(begin(), value);
+        const Chunk *chunk;
+        std::size_t index;
+        if (!locate(pos, chunk, index)) return nullptr;
+        return &*emplace(const_iterator(chunk, index), value);
+    }
+
+    // Returns the element that followed pos, or nullptr.
+    T *erase(const T *pos) {
+        const Chunk *chunk;
+        std::size_t index;
+        if (!pos || !locate(pos, chunk, index) || index == chunk->count) return nullptr;
+        iterator next = erase(const_iterator(chunk, index));
+        return next == end() ? nullptr : &*next;
+    }
+
+    void push_back(const T &value) { emplace(end(), value); }
+    void push_back(T &&value) { emplace(end(), std::move(value)); }
+
+    void push_front(const T &value) { emplace(begin(), value); }
+    void push_front(T &&value) { emplace(begin(), std::move(value)); }
+
+    void pop_back() {
+        if (!tail) return;
+        std::destroy_at(tail->items() + --tail->count);
+        --list_size;
+        if (tail->count == 0) free_chunk(tail);
+    }
+
+    void pop_front() {
+        if (head) erase(begin());
+    }
+
+    void clear() { destroy_chunks(); }
+
+    void resize(std::size_t count, const T &value = T()) {
+        while (list_size > count) pop_back();
+        while (list_size < count) push_back(value);
+    }
+
+    // Moves all elements of other in front of pos. other's chunks are linked
+    // in as they are; only the chunk at pos may be split.
+    void splice(const_iterator pos, UnrolledList &other) {
+        if (this == &other || !other.head) return;
+        Chunk *c = const_cast<Chunk *>(pos.chunk);
+        Chunk *next = nullptr;
+        if (c) {
+            if (pos.index == 0) {
+                next = c;
+            } else {
+                if (pos.index < c->count) split(c, pos.index);
+                next = c->next;
+            }
+        }
+        Chunk *prev = next ? next->prev : tail;
+        other.head->prev = prev;
+        other.tail->next = next;
+        if (prev) prev->next = other.head;
+        else head = other.head;
+        if (next) next->prev = other.tail;
+        else tail = other.tail;
+        list_size += other.list_size;
+        other.head = other.tail = nullptr;
+        other.list_size = 0;
+    }
+
+    void splice(const_iterator pos, UnrolledList &&other) {
+        splice(pos, other);
+    }
+
+    // Moves the element at it from other in front of pos. Elements live
+    // inside chunks, so the value is moved rather than relinked.
+    void splice(const_iterator pos, UnrolledList &other, const_iterator it) {
+        if (this == &other) {
+            iterator first = it.unconst(), after = std::next(first), target = pos.unconst();
+            if (target == first || target == after) return;
+            if (precedes(after, target)) std::rotate(first, after, target);
+            else std::rotate(target, first, after);
+            return;
+        }
+        emplace(pos, std::move(*it.unconst()));
+        other.erase(it);
+    }
+
+    // Moves [first, last) from other in front of pos.
+    void splice_range(const_iterator pos, UnrolledList &other, const_iterator first, const_iterator last) {
+        if (first == last) return;
+        if (this == &other) {
+            iterator from = first.unconst(), to = last.unconst(), target = pos.unconst();
+            if (target == to) return;
+            if (precedes(to, target)) std::rotate(from, to, target);
+            else std::rotate(target, from, to);
+            return;
+        }
+        for (const_iterator it = first; it != last; ++it) {
+            pos = std::next(emplace(pos, std::move(*it.unconst())));
+        }
+        other.erase(first, last);
+    }
+
+    // Merges the sorted list other into this sorted list. Equal elements
+    // from this list come first. The elements are moved into fresh, full
+    // chunks, so iterators into both lists are invalidated.
+    template <typename Compare>
+    void merge(UnrolledList &other, Compare comp) {
+        if (this == &other || !other.head) return;
+        UnrolledList result;
+        iterator a = begin(), b = other.begin();
+        iterator a_end = end(), b_end = other.end();
+        while (a != a_end && b != b_end) {
+            if (comp(*b, *a)) result.push_back(std::move(*b++));
+            else result.push_back(std::move(*a++));
+        }
+        for (; a != a_end; ++a) result.push_back(std::move(*a));
+        for (; b != b_end; ++b) result.push_back(std::move(*b));
+        swap(result);
+        other.clear();
+    }
+
+    template <typename Compare>
+    void merge(UnrolledList &&other, Compare comp) {
+        merge(other, comp);
+    }
+
+    void merge(UnrolledList &other) {
+        merge(other, std::less<>());
+    }
+
+    void merge(UnrolledList &&other) {
+        merge(other, std::less<>());
+    }
+
+    // Stable sort. The elements are moved out into a contiguous buffer,
+    // sorted there and moved back, so the chunk layout is kept but a
+    // reference keeps its position rather than its value.
+    template <typename Compare>
+    void sort(Compare comp) {
+        if (list_size < 2) return;
+        std::vector<T> buffer;
+        buffer.reserve(list_size);
+        for (T &item : *this) buffer.push_back(std::move(item));
+        std::stable_sort(buffer.begin(), buffer.end(), comp);
+        auto source = buffer.begin();
+        for (T &item : *this) item = std::move(*source++);
+    }
+
+    void sort() {
+        sort(std::less<>());
+    }
+
+    // Removes consecutive elements for which pred holds in one compaction
+    // pass; returns how many were removed.
+    template <typename BinaryPredicate>
+    std::size_t unique(BinaryPredicate pred) {
+        if (list_size < 2) return 0;
+        iterator write = begin(), read = std::next(write), e = end();
+        std::size_t kept = 1;
+        for (; read != e; ++read) {
+            if (pred(*write, *read)) continue;
+            ++write;
+            if (write != read) *write = std::move(*read);
+            ++kept;
+        }
+        std::size_t removed = list_size - kept;
+        for (std::size_t n = removed; n > 0; --n) pop_back();
+        return removed;
+    }
+
+    std::size_t unique() {
+        return unique(std::equal_to<>());
+    }
+
+    void reverse() noexcept(std::is_nothrow_swappable_v<T>) {
+        for (Chunk *c = head; c; c = c->prev) {
+            std::swap(c->prev, c->next);
+            std::reverse(c->items(), c->items() + c->count);
+        }
+        std::swap(head, tail);
+    }
+
+    void swap(UnrolledList &other) noexcept {
+        std::swap(head, other.head);
+        std::swap(tail, other.tail);
+        std::swap(list_size, other.list_size);
+    }
+
+    bool operator==(const UnrolledList &other) const {
+        return list_size == other.list_size && std::equal(begin(), end(), other.begin());
+    }
+
+    bool operator==(const Container<T>& other) const override {
+        auto* lst = dynamic_cast<const UnrolledList*>(&other);
+        return lst && *this == *lst;
+    }
+
+    bool operator!=(const Container<T>& other) const override {
+        return !(*this == other);
+    }
+
+    std::strong_ordering operator<=>(const UnrolledList &other) const {
+        const_iterator a = begin(), b = other.begin();
+        for (std::size_t n = std::min(list_size, other.list_size); n > 0; --n, ++a, ++b) {
+            if (auto cmp = *a <=> *b; cmp != 0) return cmp;
+        }
+        return list_size <=> other.list_size;
+    }
+
+    bool operator<(const UnrolledList &other) const { return (*this <=> other) < 0; }
+    bool operator<=(const UnrolledList &other) const { return (*this <=> other) <= 0; }
+    bool operator>(const UnrolledList &other) const { return (*this <=> other) > 0; }
+    bool operator>=(const UnrolledList &other) const { return (*this <=> other) >= 0; }
+};
+
+#endif //DEQUE_UNROLLEDLIST_HPP
@@ -6,54 +6,221 @@
 #include <compare>
 #include <cstddef>
 #include <algorithm>
+#include <memory>
+#include <new>
+#include <type_traits>
+#include <iterator>
+#include <ranges>
+#include <cstring>
+#include <cstdlib>
+#include <functional>
+#include <span>
+#include <optional>
+#include <atomic>
+
+#include "simd.hpp"
+#include "threadpool.hpp"
+#include "container.hpp"
 
 #ifndef VECTOR_VECTOR_HPP
 #define VECTOR_VECTOR_HPP
 
-template <typename T>
-class Container {
-public:
-    Container() = default;
-    Container(const Container& other) = default;
-    virtual Container& operator=(const Container& other) = 0;
-    virtual ~Container() = 0;
+namespace my_container {
+
+    // A type is trivially relocatable when moving an object to a new address
+    // and ending the lifetime of the original is equivalent to copying its
+    // bytes. Types that hold no self-pointers (e.g. unique_ptr-like handles)
+    // can opt in by specializing this trait.
+    template <typename T>
+    struct is_trivially_relocatable : std::bool_constant<std::is_trivially_copyable_v<T>> {};
 
-    virtual bool operator==(const Container& other) const = 0;
-    virtual bool operator!=(const Container& other) const = 0;
+    template <typename T>
+    inline constexpr bool is_trivially_relocatable_v = is_trivially_relocatable<T>::value;
 
-    virtual std::size_t size() const = 0;
-    virtual std::size_t max_size() const = 0;
-    virtual bool empty() const = 0;
-};
-template <typename T>
-Container<T>:: ~Container() = default;
+    namespace detail {
 
-namespace my_container {
+        // Moves [first, last) into uninitialized dest, falling back to copying
+        // when a throwing move could lose elements. The originals are kept.
+        template <typename T>
+        void uninitialized_transfer(T* first, T* last, T* dest) {
+            if constexpr (std::is_nothrow_move_constructible_v<T> || !std::is_copy_constructible_v<T>) {
+                std::uninitialized_move(first, last, dest);
+            } else {
+                std::uninitialized_copy(first, last, dest);
+            }
+        }
+
+        template <typename T>
+        void relocate(T* first, T* last, T* dest) {
+            if constexpr (is_trivially_relocatable_v<T>) {
+                if (first != last) {
+                    std::memcpy(static_cast<void*>(dest), static_cast<const void*>(first),
+                                static_cast<std::size_t>(last - first) * sizeof(T));
+                }
+            } else {
+                uninitialized_transfer(first, last, dest);
+                std::destroy(first, last);
+            }
+        }
+
+        // Room for N elements inside the vector object itself.
+        template <typename T, std::size_t N>
+        struct InlineBuffer {
+            T* data() noexcept {
+                return reinterpret_cast<T*>(bytes);
+            }
+
+            const T* data() const noexcept {
+                return reinterpret_cast<const T*>(bytes);
+            }
+
+            alignas(T) unsigned char bytes[N * sizeof(T)];
+        };
+
+        template <typename T>
+        struct InlineBuffer<T, 0> {
+            T* data() const noexcept {
+                return nullptr;
+            }
+        };
+
+    }  // namespace detail
+
+    // Growth policies decide the capacity to allocate when an insertion needs
+    // at least `required` elements and the current capacity is too small.
+    struct GrowDouble {
+        static std::size_t next_capacity(std::size_t capacity, std::size_t required, std::size_t) noexcept {
+            return std::max(capacity == 0 ? std::size_t{1} : capacity * 2, required);
+        }
+    };
+
+    struct GrowOneAndHalf {
+        static std::size_t next_capacity(std::size_t capacity, std::size_t required, std::size_t) noexcept {
+            return std::max(capacity + capacity / 2 + 1, required);
+        }
+    };
+
+    // Doubles, then rounds allocations of a page or more up to whole pages.
+    template <std::size_t PageSize = 4096>
+    struct GrowPageRounded {
+        static std::size_t next_capacity(std::size_t capacity, std::size_t required,
+                                         std::size_t element_size) noexcept {
+            std::size_t count = GrowDouble::next_capacity(capacity, required, element_size);
+            std::size_t bytes = count * element_size;
+            if (bytes < PageSize) return count;
+            return (bytes + PageSize - 1) / PageSize * PageSize / element_size;
+        }
+    };
+
+    template <std::size_t Step>
+    struct GrowFixedStep {
+        static_assert(Step > 0, "GrowFixedStep needs a positive step");
 
-    template<typename T>
+        static std::size_t next_capacity(std::size_t capacity, std::size_t required, std::size_t) noexcept {
+            return std::max(capacity + Step, required);
+        }
+    };
+
+    // Stats hooks are told about every reallocation and about the final size
+    // and capacity when a vector is destroyed. The default does nothing.
+    struct NoVectorStats {
+        void on_reallocate(std::size_t, std::size_t, std::size_t) noexcept {}
+        void on_destroy(std::size_t, std::size_t, std::size_t) noexcept {}
+    };
+
+    // Counters shared by every vector whose VectorStatsHook points at them.
+    struct VectorStats {
+        std::atomic<std::size_t> reallocations{0};
+        std::atomic<std::size_t> bytes_moved{0};
+        std::atomic<std::size_t> peak_capacity{0};
+        std::atomic<std::size_t> wasted_bytes{0};
+    };
+
+    class VectorStatsHook {
+    public:
+        VectorStatsHook(VectorStats* sink = nullptr) noexcept : sink_(sink) {}
+
+        VectorStats* sink() const noexcept {
+            return sink_;
+        }
+
+        void on_reallocate(std::size_t, std::size_t new_capacity, std::size_t bytes_moved) noexcept {
+            if (!sink_) return;
+            sink_->reallocations.fetch_add(1, std::memory_order_relaxed);
+            sink_->bytes_moved.fetch_add(bytes_moved, std::memory_order_relaxed);
+            std::size_t peak = sink_->peak_capacity.load(std::memory_order_relaxed);
+            while (peak < new_capacity &&
+                   !sink_->peak_capacity.compare_exchange_weak(peak, new_capacity, std::memory_order_relaxed)) {
+            }
+        }
+
+        void on_destroy(std::size_t size, std::size_t capacity, std::size_t element_size) noexcept {
+            if (sink_) sink_->wasted_bytes.fetch_add((capacity - size) * element_size, std::memory_order_relaxed);
+        }
+
+    private:
+        VectorStats* sink_;
+    };
+
+    // With a non-zero InlineCapacity the first InlineCapacity elements are
+    // stored inside the object and the heap is used only once the size
+    // exceeds it; see SmallVector.
+    template<typename T, typename Allocator = std::allocator<T>, typename GrowthPolicy = GrowDouble,
+             typename StatsHook = NoVectorStats, std::size_t InlineCapacity = 0>
     class Vector : public Container<T> {
+        using alloc_traits = std::allocator_traits<Allocator>;
+
+        // Moving an inline buffer moves the elements themselves.
+        static constexpr bool nothrow_steal = InlineCapacity == 0 || std::is_nothrow_move_constructible_v<T>;
+
     public:
+        using allocator_type = Allocator;
+        using growth_policy = GrowthPolicy;
+        using stats_hook_type = StatsHook;
+
         Vector() = default;
 
+        explicit Vector(const Allocator& alloc) noexcept : alloc_(alloc) {}
+
         Vector(const Vector& other)
-                : size_(other.size_), capacity_(other.capacity_), data_(new T[capacity_]) {
-            std::copy(other.data_, other.data_ + size_, data_);
+                : Vector(other, alloc_traits::select_on_container_copy_construction(other.alloc_)) {}
+
+        Vector(const Vector& other, const Allocator& alloc) : alloc_(alloc), stats_(other.stats_) {
+            init_storage(other.capacity_);
+            try {
+                std::uninitialized_copy(other.data_, other.data_ + other.size_, data_);
+            } catch (...) {
+                deallocate(data_, capacity_);
+                throw;
+            }
+            size_ = other.size_;
         }
 
-        Vector(Vector&& other) noexcept
-                : size_(other.size_), capacity_(other.capacity_), data_(other.data_) {
-            other.data_ = nullptr;
-            other.size_ = 0;
-            other.capacity_ = 0;
+        Vector(Vector&& other) noexcept(nothrow_steal)
+                : alloc_(std::move(other.alloc_)), stats_(other.stats_) {
+            steal(other);
+        }
+
+        Vector(std::initializer_list<T> init, const Allocator& alloc = Allocator()) : alloc_(alloc) {
+            init_storage(init.size());
+            try {
+                std::uninitialized_copy(init.begin(), init.end(), data_);
+            } catch (...) {
+                deallocate(data_, capacity_);
+                throw;
+            }
+            size_ = init.size();
         }
 
-        Vector(std::initializer_list<T> init)
-                : size_(init.size()), capacity_(init.size()), data_(new T[capacity_]) {
-            std::copy(init.begin(), init.end(), data_);
+        template <std::input_iterator InputIt>
+        Vector(InputIt first, InputIt last, const Allocator& alloc = Allocator()) : alloc_(alloc) {
+            insert(0, first, last);
         }
 
         ~Vector() override {
-            delete[] data_;
+            stats_.on_destroy(size_, capacity_, sizeof(T));
+            std::destroy(data_, data_ + size_);
+            deallocate(data_, capacity_);
         }
 
         Container<T>& operator=(const Container<T>& other) override {
@@ -62,7 +229,11 @@ namespace my_container {
                 if (!vec) {
                     throw std::invalid_argument("Assigned Container must be of type Vector");
                 }
-                *this = *vec;
+                if constexpr (std::is_copy_constructible_v<T>) {
+                    *this = *vec;
+                } else {
+                    throw std::invalid_argument("Vector element type is not copyable");
+                }
             }
             return *this;
         }
@@ -70,29 +241,48 @@ namespace my_container {
 
         Vector& operator=(const Vector& other) {
             if (this != &other) {
-                T* new_data = new T[other.capacity_];
-                std::copy(other.data_, other.data_ + other.size_, new_data);
-                delete[] data_;
-                data_ = new_data;
-                size_ = other.size_;
-                capacity_ = other.capacity_;
+                if constexpr (alloc_traits::propagate_on_container_copy_assignment::value) {
+                    Vector tmp(other, other.alloc_);
+                    adopt(tmp);
+                } else {
+                    Vector tmp(other, alloc_);
+                    adopt(tmp);
+                }
             }
             return *this;
         }
 
-        Vector& operator=(Vector&& other) noexcept {
+        Vector& operator=(Vector&& other) noexcept((alloc_traits::propagate_on_container_move_assignment::value ||
+                                                    alloc_traits::is_always_equal::value) && nothrow_steal) {
             if (this != &other) {
-                delete[] data_;
-                data_ = other.data_;
-                size_ = other.size_;
-                capacity_ = other.capacity_;
-                other.data_ = nullptr;
-                other.size_ = 0;
-                other.capacity_ = 0;
+                if constexpr (!alloc_traits::propagate_on_container_move_assignment::value &&
+                              !alloc_traits::is_always_equal::value) {
+                    if (alloc_ != other.alloc_) {
+                        clear();
+                        reserve(other.size_);
+                        std::uninitialized_move(other.data_, other.data_ + other.size_, data_);
+                        size_ = other.size_;
+                        other.clear();
+                        return *this;
+                    }
+                }
+                adopt(other);
             }
             return *this;
         }
 
+        allocator_type get_allocator() const noexcept {
+            return alloc_;
+        }
+
+        StatsHook& stats_hook() noexcept {
+            return stats_;
+        }
+
+        const StatsHook& stats_hook() const noexcept {
+            return stats_;
+        }
+
         T& operator[](std::size_t index) {
             return data_[index];
         }
@@ -135,6 +325,30 @@ namespace my_container {
             return data_;
         }
 
+        T* begin() noexcept {
+            return data_;
+        }
+
+        const T* begin() const noexcept {
+            return data_;
+        }
+
+        T* end() noexcept {
+            return data_ + size_;
+        }
+
+        const T* end() const noexcept {
+            return data_ + size_;
+        }
+
+        const T* cbegin() const noexcept {
+            return data_;
+        }
+
+        const T* cend() const noexcept {
+            return data_ + size_;
+        }
+
         bool empty() const override {
             return size_ == 0;
         }
@@ -147,70 +361,279 @@ namespace my_container {
             return capacity_;
         }
 
+        static constexpr std::size_t inline_capacity() noexcept {
+            return InlineCapacity;
+        }
+
+        // Whether the elements currently live in the inline buffer.
+        bool is_inline() const noexcept requires(InlineCapacity > 0) {
+            return uses_inline();
+        }
+
         std::size_t max_size() const override {
-            return static_cast<std::size_t>(-1) / sizeof(T);
+            return alloc_traits::max_size(alloc_);
         }
 
         void reserve(std::size_t new_cap) {
             if (new_cap > capacity_) {
-                T* new_data = new T[new_cap];
-                std::copy(data_, data_ + size_, new_data);
-                delete[] data_;
-                data_ = new_data;
-                capacity_ = new_cap;
+                reallocate(new_cap);
             }
         }
 
         void shrink_to_fit() {
             if (capacity_ > size_) {
-                T* new_data = new T[size_];
-                std::copy(data_, data_ + size_, new_data);
-                delete[] data_;
-                data_ = new_data;
-                capacity_ = size_;
+                reallocate(size_);
             }
         }
 
         void clear() {
+            std::destroy(data_, data_ + size_);
             size_ = 0;
         }
 
         void push_back(const T& value) {
-            if (size_ >= capacity_) reserve(capacity_ == 0 ? 1 : capacity_ * 2);
-            data_[size_++] = value;
+            emplace_back(value);
+        }
+
+        void push_back(T&& value) {
+            emplace_back(std::move(value));
+        }
+
+        template <typename... Args>
+        T& emplace_back(Args&&... args) {
+            if (size_ < capacity_) {
+                ::new (static_cast<void*>(data_ + size_)) T(std::forward<Args>(args)...);
+                return data_[size_++];
+            }
+            std::size_t new_cap = next_capacity(size_ + 1);
+            if constexpr (uses_realloc) {
+                alignas(T) unsigned char slot[sizeof(T)];
+                ::new (static_cast<void*>(slot)) T(std::forward<Args>(args)...);
+                try {
+                    reallocate(new_cap);
+                } catch (...) {
+                    std::launder(reinterpret_cast<T*>(slot))->~T();
+                    throw;
+                }
+                std::memcpy(static_cast<void*>(data_ + size_), slot, sizeof(T));
+                return data_[size_++];
+            }
+            T* new_data = allocate(new_cap);
+            try {
+                ::new (static_cast<void*>(new_data + size_)) T(std::forward<Args>(args)...);
+            } catch (...) {
+                deallocate(new_data, new_cap);
+                throw;
+            }
+            try {
+                detail::relocate(data_, data_ + size_, new_data);
+            } catch (...) {
+                new_data[size_].~T();
+                deallocate(new_data, new_cap);
+                throw;
+            }
+            replace_storage(new_data, new_cap);
+            return data_[size_++];
+        }
+
+        template <std::ranges::input_range R>
+        void append_range(R&& range) {
+            if constexpr (std::ranges::common_range<R>) {
+                insert(size_, std::ranges::begin(range), std::ranges::end(range));
+            } else {
+                for (auto&& item : range) emplace_back(std::forward<decltype(item)>(item));
+            }
         }
 
         void pop_back() {
-            if (size_ > 0) --size_;
+            if (size_ > 0) {
+                --size_;
+                data_[size_].~T();
+            }
         }
 
         void insert(std::size_t pos, const T& value) {
+            emplace(pos, value);
+        }
+
+        void insert(std::size_t pos, T&& value) {
+            emplace(pos, std::move(value));
+        }
+
+        template <typename... Args>
+        T& emplace(std::size_t pos, Args&&... args) {
             if (pos > size_) throw std::out_of_range("Insert position out of range");
-            if (size_ >= capacity_) reserve(capacity_ == 0 ? 1 : capacity_ * 2);
-            for (std::size_t i = size_; i > pos; --i) {
-                data_[i] = std::move(data_[i - 1]);
+            if (pos == size_) return emplace_back(std::forward<Args>(args)...);
+            if constexpr (is_trivially_relocatable_v<T>) {
+                alignas(T) unsigned char slot[sizeof(T)];
+                ::new (static_cast<void*>(slot)) T(std::forward<Args>(args)...);
+                if (size_ >= capacity_) {
+                    try {
+                        reserve(next_capacity(size_ + 1));
+                    } catch (...) {
+                        std::launder(reinterpret_cast<T*>(slot))->~T();
+                        throw;
+                    }
+                }
+                std::memmove(static_cast<void*>(data_ + pos + 1), static_cast<const void*>(data_ + pos),
+                             (size_ - pos) * sizeof(T));
+                std::memcpy(static_cast<void*>(data_ + pos), slot, sizeof(T));
+                ++size_;
+                return data_[pos];
             }
-            data_[pos] = value;
+            T tmp(std::forward<Args>(args)...);
+            if (size_ >= capacity_) reserve(next_capacity(size_ + 1));
+            ::new (static_cast<void*>(data_ + size_)) T(std::move(data_[size_ - 1]));
             ++size_;
+            std::move_backward(data_ + pos, data_ + size_ - 2, data_ + size_ - 1);
+            data_[pos] = std::move(tmp);
+            return data_[pos];
+        }
+
+        // The range must not refer to elements of this vector.
+        template <std::input_iterator InputIt>
+        void insert(std::size_t pos, InputIt first, InputIt last) {
+            if (pos > size_) throw std::out_of_range("Insert position out of range");
+            if constexpr (std::forward_iterator<InputIt>) {
+                std::size_t count = static_cast<std::size_t>(std::distance(first, last));
+                if (count == 0) return;
+                if (size_ + count > capacity_) {
+                    insert_reallocate(pos, first, last, count);
+                } else {
+                    insert_in_place(pos, first, last, count);
+                }
+            } else {
+                std::size_t old_size = size_;
+                for (; first != last; ++first) emplace_back(*first);
+                std::rotate(data_ + pos, data_ + old_size, data_ + size_);
+            }
+        }
+
+        // Inserts values[i] before the element originally at positions[i].
+        // Positions must be non-decreasing; equal positions keep the order of
+        // their values. The whole tail is spread out in a single pass. values
+        // may refer to elements of this vector; they are copied out first.
+        void insert_many(std::span<const std::size_t> positions, std::span<const T> values) {
+            if (positions.size() != values.size()) {
+                throw std::invalid_argument("insert_many needs one value per position");
+            }
+            std::less<const T*> less;
+            if (!values.empty() && less(values.data(), data_ + size_) && less(data_, values.data() + values.size())) {
+                Vector copy(alloc_);
+                copy.reserve(values.size());
+                for (const T& value : values) copy.push_back(value);
+                insert_many(positions, std::span<const T>(copy.data(), copy.size()));
+                return;
+            }
+            for (std::size_t i = 0; i < positions.size(); ++i) {
+                if (positions[i] > size_) throw std::out_of_range("Insert position out of range");
+                if (i > 0 && positions[i] < positions[i - 1]) {
+                    throw std::invalid_argument("insert_many positions must be sorted");
+                }
+            }
+            std::size_t count = positions.size();
+            if (count == 0) return;
+            if (size_ + count > capacity_) reserve(next_capacity(size_ + count));
+
+            std::size_t old_size = size_;
+            std::size_t read = old_size;
+            std::size_t write = old_size + count;
+            if constexpr (is_trivially_relocatable_v<T> && std::is_nothrow_copy_constructible_v<T>) {
+                for (std::size_t j = count; j > 0; --j) {
+                    std::size_t run = read - positions[j - 1];
+                    write -= run;
+                    read -= run;
+                    std::memmove(static_cast<void*>(data_ + write), static_cast<const void*>(data_ + read),
+                                 run * sizeof(T));
+                    --write;
+                    ::new (static_cast<void*>(data_ + write)) T(values[j - 1]);
+                }
+            } else {
+                std::size_t constructed = write;
+                auto place = [&](std::size_t index, auto&& value) {
+                    if (index >= old_size) {
+                        ::new (static_cast<void*>(data_ + index)) T(std::forward<decltype(value)>(value));
+                        constructed = index;
+                    } else {
+                        data_[index] = std::forward<decltype(value)>(value);
+                    }
+                };
+                try {
+                    for (std::size_t j = count; j > 0; --j) {
+                        while (read > positions[j - 1]) place(--write, std::move(data_[--read]));
+                        place(--write, values[j - 1]);
+                    }
+                } catch (...) {
+                    std::destroy(data_ + std::max(constructed, old_size), data_ + old_size + count);
+                    throw;
+                }
+            }
+            size_ = old_size + count;
         }
 
         void erase(std::size_t pos) {
             if (pos >= size_) throw std::out_of_range("Erase position out of range");
-            for (std::size_t i = pos; i < size_ - 1; ++i) {
-                data_[i] = std::move(data_[i + 1]);
+            erase(pos, pos + 1);
+        }
+
+        void erase(std::size_t first, std::size_t last) {
+            if (first > last || last > size_) throw std::out_of_range("Erase range out of range");
+            if (first == last) return;
+            if constexpr (is_trivially_relocatable_v<T>) {
+                std::destroy(data_ + first, data_ + last);
+                std::memmove(static_cast<void*>(data_ + first), static_cast<const void*>(data_ + last),
+                             (size_ - last) * sizeof(T));
+            } else {
+                std::move(data_ + last, data_ + size_, data_ + first);
+                std::destroy(data_ + size_ - (last - first), data_ + size_);
             }
-            --size_;
+            size_ -= last - first;
+        }
+
+        // Removes every element matching pred with a single compaction pass
+        // and returns the number of removed elements.
+        template <typename Predicate>
+        std::size_t erase_if(Predicate pred) {
+            std::size_t write = 0;
+            while (write < size_ && !pred(data_[write])) ++write;
+            for (std::size_t read = write + 1; read < size_; ++read) {
+                if (!pred(data_[read])) {
+                    data_[write++] = std::move(data_[read]);
+                }
+            }
+            std::size_t removed = size_ - write;
+            std::destroy(data_ + write, data_ + size_);
+            size_ = write;
+            return removed;
         }
 
         void resize(std::size_t count, const T& value = T()) {
-            if (count > capacity_) reserve(count);
-            if (count > size_) {
-                std::fill(data_ + size_, data_ + count, value);
+            if (count < size_) {
+                std::destroy(data_ + count, data_ + size_);
+                size_ = count;
+            } else if (count > size_) {
+                if (count > capacity_) {
+                    T tmp(value);
+                    reserve(count);
+                    std::uninitialized_fill(data_ + size_, data_ + count, tmp);
+                } else {
+                    std::uninitialized_fill(data_ + size_, data_ + count, value);
+                }
+                size_ = count;
             }
-            size_ = count;
         }
 
-        void swap(Vector& other) noexcept {
+        void swap(Vector& other) noexcept(nothrow_steal && (InlineCapacity == 0 || std::is_nothrow_swappable_v<T>)) {
+            if (this == &other) return;
+            if constexpr (alloc_traits::propagate_on_container_swap::value) {
+                std::swap(alloc_, other.alloc_);
+            }
+            if constexpr (InlineCapacity > 0) {
+                if (uses_inline() || other.uses_inline()) {
+                    swap_inline(other);
+                    return;
+                }
+            }
             std::swap(data_, other.data_);
             std::swap(size_, other.size_);
             std::swap(capacity_, other.capacity_);
@@ -219,7 +642,11 @@ namespace my_container {
         bool operator==(const Container<T>& other) const override {
             auto* p = dynamic_cast<const Vector*>(&other);
             if (!p || p->size_ != size_) return false;
-            return std::equal(data_, data_ + size_, p->data_);
+            if constexpr (simd::vectorizable<T>) {
+                return simd::equal(data_, p->data_, size_);
+            } else {
+                return std::equal(data_, data_ + size_, p->data_);
+            }
         }
 
         bool operator!=(const Container<T>& other) const override {
@@ -228,17 +655,378 @@ namespace my_container {
 
         std::strong_ordering operator<=>(const Vector& other) const {
             if (auto cmp = size_ <=> other.size_; cmp != 0) return cmp;
-            for (std::size_t i = 0; i < size_; ++i) {
-                if (auto cmp = data_[i] <=> other.data_[i]; cmp != 0) return cmp;
+            if constexpr (simd::vectorizable<T>) {
+                std::size_t i = simd::mismatch(data_, other.data_, size_);
+                return i == size_ ? std::strong_ordering::equal : data_[i] <=> other.data_[i];
+            } else {
+                for (std::size_t i = 0; i < size_; ++i) {
+                    if (auto cmp = data_[i] <=> other.data_[i]; cmp != 0) return cmp;
+                }
+                return std::strong_ordering::equal;
+            }
+        }
+
+        // Index of the first element equal to value, or size() if there is none.
+        std::size_t find(const T& value) const {
+            if constexpr (simd::vectorizable<T>) {
+                return simd::find(data_, size_, value);
+            } else {
+                return static_cast<std::size_t>(std::find(data_, data_ + size_, value) - data_);
+            }
+        }
+
+        std::size_t count(const T& value) const {
+            if constexpr (simd::vectorizable<T>) {
+                return simd::count(data_, size_, value);
+            } else {
+                return static_cast<std::size_t>(std::count(data_, data_ + size_, value));
+            }
+        }
+
+        T min() const {
+            if (size_ == 0) throw std::out_of_range("Vector is empty");
+            if constexpr (simd::vectorizable<T>) {
+                return simd::min(data_, size_);
+            } else {
+                return *std::min_element(data_, data_ + size_);
+            }
+        }
+
+        T max() const {
+            if (size_ == 0) throw std::out_of_range("Vector is empty");
+            if constexpr (simd::vectorizable<T>) {
+                return simd::max(data_, size_);
+            } else {
+                return *std::max_element(data_, data_ + size_);
+            }
+        }
+
+        T sum() const {
+            if constexpr (simd::vectorizable<T>) {
+                return simd::sum(data_, size_);
+            } else {
+                T result{};
+                for (std::size_t i = 0; i < size_; ++i) result = result + data_[i];
+                return result;
+            }
+        }
+
+
+        // The parallel_* operations split the elements into cache-line-aligned
+        // chunks and run them on a thread pool; see ParallelOptions. Elements
+        // are constructed in parallel only when copying cannot throw.
+        void parallel_fill(const T& value, const ParallelOptions& options = {}) {
+            ChunkPlan(data_, size_, options).run([&](std::size_t, std::size_t first, std::size_t last) {
+                std::fill(data_ + first, data_ + last, value);
+            });
+        }
+
+        void parallel_fill(std::size_t count, const T& value, const ParallelOptions& options = {}) {
+            T tmp(value);
+            clear();
+            reserve(count);
+            if constexpr (std::is_nothrow_copy_constructible_v<T>) {
+                ChunkPlan(data_, count, options).run([&](std::size_t, std::size_t first, std::size_t last) {
+                    std::uninitialized_fill(data_ + first, data_ + last, tmp);
+                });
+            } else {
+                std::uninitialized_fill(data_, data_ + count, tmp);
+            }
+            size_ = count;
+        }
+
+        void parallel_copy_from(std::span<const T> source, const ParallelOptions& options = {}) {
+            if (source.data() == data_ && source.size() == size_) return;
+            std::less<const T*> less;
+            if (less(source.data(), data_ + capacity_) && less(data_, source.data() + source.size())) {
+                Vector tmp(alloc_);
+                tmp.parallel_copy_from(source, options);
+                swap(tmp);
+                return;
             }
-            return std::strong_ordering::equal;
+            clear();
+            reserve(source.size());
+            if constexpr (std::is_nothrow_copy_constructible_v<T>) {
+                ChunkPlan(data_, source.size(), options).run([&](std::size_t, std::size_t first, std::size_t last) {
+                    std::uninitialized_copy(source.data() + first, source.data() + last, data_ + first);
+                });
+            } else {
+                std::uninitialized_copy(source.begin(), source.end(), data_);
+            }
+            size_ = source.size();
         }
 
+        // Replaces every element x with op(x).
+        template <typename UnaryOp>
+        void parallel_transform(UnaryOp op, const ParallelOptions& options = {}) {
+            ChunkPlan(data_, size_, options).run([&](std::size_t, std::size_t first, std::size_t last) {
+                for (std::size_t i = first; i < last; ++i) data_[i] = op(std::move(data_[i]));
+            });
+        }
+
+        // Folds the elements with op, which must be associative; chunks are
+        // combined left to right, starting from init.
+        template <typename BinaryOp>
+        T parallel_reduce(T init, BinaryOp op, const ParallelOptions& options = {}) const {
+            struct alignas(cache_line_size) Partial {
+                std::optional<T> value;
+            };
+            ChunkPlan plan(data_, size_, options);
+            std::unique_ptr<Partial[]> partials(new Partial[plan.tasks()]);
+            plan.run([&](std::size_t task, std::size_t first, std::size_t last) {
+                T acc = data_[first];
+                for (std::size_t i = first + 1; i < last; ++i) acc = op(std::move(acc), data_[i]);
+                partials[task].value.emplace(std::move(acc));
+            });
+            for (std::size_t task = 0; task < plan.tasks(); ++task) {
+                init = op(std::move(init), std::move(*partials[task].value));
+            }
+            return init;
+        }
 
     private:
+        // With the default allocator, trivially relocatable elements live in
+        // malloc'd memory so that growth can be done in place by realloc.
+        static constexpr bool uses_realloc = std::is_same_v<Allocator, std::allocator<T>> &&
+                                             is_trivially_relocatable_v<T> &&
+                                             alignof(T) <= alignof(std::max_align_t);
+
+        T* allocate(std::size_t n) {
+            if (n == 0) return nullptr;
+            if constexpr (uses_realloc) {
+                if (n > max_size()) throw std::bad_array_new_length();
+                void* p = std::malloc(n * sizeof(T));
+                if (!p) throw std::bad_alloc();
+                return static_cast<T*>(p);
+            } else {
+                return std::to_address(alloc_traits::allocate(alloc_, n));
+            }
+        }
+
+        void deallocate(T* p, std::size_t n) noexcept {
+            if constexpr (InlineCapacity > 0) {
+                if (p == inline_.data()) return;
+            }
+            if constexpr (uses_realloc) {
+                std::free(static_cast<void*>(p));
+            } else {
+                if (p) alloc_traits::deallocate(alloc_, p, n);
+            }
+        }
+
+        bool uses_inline() const noexcept {
+            if constexpr (InlineCapacity > 0) {
+                return data_ == inline_.data();
+            } else {
+                return false;
+            }
+        }
+
+        // Points an empty vector at storage for at least cap elements.
+        void init_storage(std::size_t cap) {
+            if (cap <= InlineCapacity) {
+                data_ = inline_.data();
+                capacity_ = InlineCapacity;
+            } else {
+                data_ = allocate(cap);
+                capacity_ = cap;
+            }
+        }
+
+        // Takes over other's elements, leaving other empty. A heap buffer
+        // changes hands; inline elements are relocated into this vector's
+        // own buffer, which must be empty.
+        void steal(Vector& other) noexcept(nothrow_steal) {
+            if (other.uses_inline()) {
+                detail::relocate(other.data_, other.data_ + other.size_, data_);
+                size_ = other.size_;
+                other.size_ = 0;
+                return;
+            }
+            data_ = other.data_;
+            size_ = other.size_;
+            capacity_ = other.capacity_;
+            other.data_ = other.inline_.data();
+            other.size_ = 0;
+            other.capacity_ = InlineCapacity;
+        }
+
+        // Releases the current storage and takes over other's storage and,
+        // when the allocator propagates, its allocator.
+        void adopt(Vector& other) noexcept(nothrow_steal) {
+            std::destroy(data_, data_ + size_);
+            deallocate(data_, capacity_);
+            size_ = 0;
+            data_ = inline_.data();
+            capacity_ = InlineCapacity;
+            if constexpr (alloc_traits::propagate_on_container_move_assignment::value ||
+                          alloc_traits::propagate_on_container_copy_assignment::value) {
+                alloc_ = std::move(other.alloc_);
+            }
+            steal(other);
+        }
+
+        // swap() when at least one side keeps its elements inline.
+        void swap_inline(Vector& other) {
+            if (!uses_inline()) {
+                other.swap_inline(*this);
+                return;
+            }
+            if (!other.uses_inline()) {
+                detail::relocate(data_, data_ + size_, other.inline_.data());
+                data_ = other.data_;
+                capacity_ = other.capacity_;
+                other.data_ = other.inline_.data();
+                other.capacity_ = InlineCapacity;
+                std::swap(size_, other.size_);
+                return;
+            }
+            Vector& longer = size_ >= other.size_ ? *this : other;
+            Vector& shorter = size_ >= other.size_ ? other : *this;
+            std::swap_ranges(shorter.data_, shorter.data_ + shorter.size_, longer.data_);
+            detail::relocate(longer.data_ + shorter.size_, longer.data_ + longer.size_,
+                             shorter.data_ + shorter.size_);
+            std::swap(size_, other.size_);
+        }
+
+        void reallocate(std::size_t new_cap) {
+            if constexpr (InlineCapacity > 0) {
+                // Shrinking back into the inline buffer.
+                if (new_cap <= InlineCapacity) {
+                    if (uses_inline()) return;
+                    detail::relocate(data_, data_ + size_, inline_.data());
+                    replace_storage(inline_.data(), InlineCapacity);
+                    return;
+                }
+            }
+            if constexpr (uses_realloc) {
+                if (new_cap == 0) {
+                    std::free(static_cast<void*>(data_));
+                    data_ = nullptr;
+                } else {
+                    if (new_cap > max_size()) throw std::bad_array_new_length();
+                    // The inline buffer cannot be realloc'd; copy out of it.
+                    void* p = uses_inline() ? std::malloc(new_cap * sizeof(T))
+                                            : std::realloc(static_cast<void*>(data_), new_cap * sizeof(T));
+                    if (!p) throw std::bad_alloc();
+                    if (uses_inline() && size_ > 0) std::memcpy(p, static_cast<const void*>(data_), size_ * sizeof(T));
+                    data_ = static_cast<T*>(p);
+                }
+                stats_.on_reallocate(capacity_, new_cap, size_ * sizeof(T));
+                capacity_ = new_cap;
+                return;
+            }
+            T* new_data = allocate(new_cap);
+            try {
+                detail::relocate(data_, data_ + size_, new_data);
+            } catch (...) {
+                deallocate(new_data, new_cap);
+                throw;
+            }
+            replace_storage(new_data, new_cap);
+        }
+
+        // Frees the old buffer once its elements have been relocated to new_data.
+        void replace_storage(T* new_data, std::size_t new_cap) noexcept {
+            stats_.on_reallocate(capacity_, new_cap, size_ * sizeof(T));
+            deallocate(data_, capacity_);
+            data_ = new_data;
+            capacity_ = new_cap;
+        }
+
+        // Capacity to grow to when at least `required` elements must fit.
+        std::size_t next_capacity(std::size_t required) const {
+            std::size_t limit = max_size();
+            if (required > limit) throw std::length_error("Vector size exceeds max_size");
+            std::size_t cap = GrowthPolicy::next_capacity(capacity_, required, sizeof(T));
+            return std::clamp(cap, required, limit);
+        }
+
+        template <typename ForwardIt>
+        void insert_reallocate(std::size_t pos, ForwardIt first, ForwardIt last, std::size_t count) {
+            std::size_t new_cap = next_capacity(size_ + count);
+            if constexpr (uses_realloc) {
+                reallocate(new_cap);
+                insert_in_place(pos, first, last, count);
+                return;
+            }
+            T* new_data = allocate(new_cap);
+            T* gap = new_data + pos;
+            if constexpr (is_trivially_relocatable_v<T>) {
+                try {
+                    std::uninitialized_copy(first, last, gap);
+                } catch (...) {
+                    deallocate(new_data, new_cap);
+                    throw;
+                }
+                detail::relocate(data_, data_ + pos, new_data);
+                detail::relocate(data_ + pos, data_ + size_, gap + count);
+                replace_storage(new_data, new_cap);
+                size_ += count;
+                return;
+            }
+            try {
+                std::uninitialized_copy(first, last, gap);
+            } catch (...) {
+                deallocate(new_data, new_cap);
+                throw;
+            }
+            try {
+                detail::uninitialized_transfer(data_, data_ + pos, new_data);
+                try {
+                    detail::uninitialized_transfer(data_ + pos, data_ + size_, gap + count);
+                } catch (...) {
+                    std::destroy(new_data, gap);
+                    throw;
+                }
+            } catch (...) {
+                std::destroy(gap, gap + count);
+                deallocate(new_data, new_cap);
+                throw;
+            }
+            std::destroy(data_, data_ + size_);
+            replace_storage(new_data, new_cap);
+            size_ += count;
+        }
+
+        template <typename ForwardIt>
+        void insert_in_place(std::size_t pos, ForwardIt first, ForwardIt last, std::size_t count) {
+            std::size_t old_size = size_;
+            std::size_t after = old_size - pos;
+            if constexpr (is_trivially_relocatable_v<T>) {
+                std::memmove(static_cast<void*>(data_ + pos + count), static_cast<const void*>(data_ + pos),
+                             after * sizeof(T));
+                try {
+                    std::uninitialized_copy(first, last, data_ + pos);
+                } catch (...) {
+                    std::memmove(static_cast<void*>(data_ + pos), static_cast<const void*>(data_ + pos + count),
+                                 after * sizeof(T));
+                    throw;
+                }
+                size_ += count;
+                return;
+            }
+            if (after > count) {
+                std::uninitialized_move(data_ + old_size - count, data_ + old_size, data_ + old_size);
+                size_ += count;
+                std::move_backward(data_ + pos, data_ + old_size - count, data_ + old_size);
+                std::copy(first, last, data_ + pos);
+            } else {
+                ForwardIt mid = std::next(first, static_cast<std::ptrdiff_t>(after));
+                std::uninitialized_copy(mid, last, data_ + old_size);
+                size_ += count - after;
+                std::uninitialized_move(data_ + pos, data_ + old_size, data_ + size_);
+                size_ += after;
+                std::copy(first, mid, data_ + pos);
+            }
+        }
+
+        [[no_unique_address]] Allocator alloc_{};
+        [[no_unique_address]] StatsHook stats_{};
+        [[no_unique_address]] detail::InlineBuffer<T, InlineCapacity> inline_;
         std::size_t size_ = 0;
-        std::size_t capacity_ = 0;
-        T* data_ = nullptr;
+        std::size_t capacity_ = InlineCapacity;
+        T* data_ = inline_.data();
     };
 
 }  // namespace my_container
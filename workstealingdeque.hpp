@@ -0,0 +1,126 @@
+#ifndef WORKSTEALINGDEQUE_WORKSTEALINGDEQUE_HPP
+#define WORKSTEALINGDEQUE_WORKSTEALINGDEQUE_HPP
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <optional>
+#include <type_traits>
+#include <vector>
+
+namespace my_container {
+
+    // Chase-Lev work-stealing deque (with the memory orderings of Le et al.,
+    // "Correct and Efficient Work-Stealing for Weak Memory Models"). One owner
+    // thread pushes and pops at the bottom; any number of thieves steal from
+    // the top. The buffer grows on push; outgrown buffers are kept until the
+    // deque is destroyed because a thief may still be reading from them.
+    template <typename T>
+    class WorkStealingDeque {
+        static_assert(std::is_trivially_copyable_v<T>, "WorkStealingDeque stores T in atomics");
+
+    public:
+        explicit WorkStealingDeque(std::size_t capacity = 64) {
+            std::size_t cap = 2;
+            while (cap < capacity) cap *= 2;
+            buffers_.push_back(std::make_unique<Buffer>(cap));
+            buffer_.store(buffers_.back().get(), std::memory_order_relaxed);
+        }
+
+        WorkStealingDeque(const WorkStealingDeque&) = delete;
+        WorkStealingDeque& operator=(const WorkStealingDeque&) = delete;
+
+        // Approximate when other threads are stealing.
+        std::size_t size() const noexcept {
+            std::int64_t b = bottom_.load(std::memory_order_relaxed);
+            std::int64_t t = top_.load(std::memory_order_relaxed);
+            return b > t ? static_cast<std::size_t>(b - t) : 0;
+        }
+
+        bool empty() const noexcept {
+            return size() == 0;
+        }
+
+        // Owner only.
+        void push(T value) {
+            std::int64_t b = bottom_.load(std::memory_order_relaxed);
+            std::int64_t t = top_.load(std::memory_order_acquire);
+            Buffer* buf = buffer_.load(std::memory_order_relaxed);
+            if (b - t >= static_cast<std::int64_t>(buf->capacity)) buf = grow(buf, t, b);
+            buf->put(b, value);
+            bottom_.store(b + 1, std::memory_order_release);
+        }
+
+        // Owner only; takes the most recently pushed element.
+        std::optional<T> pop() {
+            std::int64_t b = bottom_.load(std::memory_order_relaxed) - 1;
+            Buffer* buf = buffer_.load(std::memory_order_relaxed);
+            bottom_.store(b, std::memory_order_seq_cst);
+            std::int64_t t = top_.load(std::memory_order_seq_cst);
+            if (t > b) {
+                bottom_.store(b + 1, std::memory_order_relaxed);
+                return std::nullopt;
+            }
+            T value = buf->get(b);
+            if (t == b) {
+                // Last element: race the thieves for it.
+                bool won = top_.compare_exchange_strong(t, t + 1, std::memory_order_seq_cst,
+                                                        std::memory_order_relaxed);
+                bottom_.store(b + 1, std::memory_order_relaxed);
+                if (!won) return std::nullopt;
+            }
+            return value;
+        }
+
+        // Any thread; takes the oldest element. Returns nothing when the deque
+        // is empty or another thread won the race for the element.
+        std::optional<T> steal() {
+            std::int64_t t = top_.load(std::memory_order_seq_cst);
+            std::int64_t b = bottom_.load(std::memory_order_seq_cst);
+            if (t >= b) return std::nullopt;
+            Buffer* buf = buffer_.load(std::memory_order_acquire);
+            T value = buf->get(t);
+            if (!top_.compare_exchange_strong(t, t + 1, std::memory_order_seq_cst, std::memory_order_relaxed)) {
+                return std::nullopt;
+            }
+            return value;
+        }
+
+    private:
+        struct Buffer {
+            explicit Buffer(std::size_t cap)
+                    : capacity(cap), mask(cap - 1), slots(std::make_unique<std::atomic<T>[]>(cap)) {}
+
+            T get(std::int64_t i) const noexcept {
+                return slots[static_cast<std::size_t>(i) & mask].load(std::memory_order_relaxed);
+            }
+
+            void put(std::int64_t i, T value) noexcept {
+                slots[static_cast<std::size_t>(i) & mask].store(value, std::memory_order_relaxed);
+            }
+
+            std::size_t capacity;
+            std::size_t mask;
+            std::unique_ptr<std::atomic<T>[]> slots;
+        };
+
+        Buffer* grow(Buffer* old, std::int64_t top, std::int64_t bottom) {
+            auto bigger = std::make_unique<Buffer>(old->capacity * 2);
+            for (std::int64_t i = top; i < bottom; ++i) bigger->put(i, old->get(i));
+            Buffer* buf = bigger.get();
+            buffers_.push_back(std::move(bigger));
+            buffer_.store(buf, std::memory_order_release);
+            return buf;
+        }
+
+        alignas(64) std::atomic<std::int64_t> top_{0};
+        alignas(64) std::atomic<std::int64_t> bottom_{0};
+        alignas(64) std::atomic<Buffer*> buffer_{nullptr};
+        // Touched by the owner only.
+        std::vector<std::unique_ptr<Buffer>> buffers_;
+    };
+
+}  // namespace my_container
+
+#endif //WORKSTEALINGDEQUE_WORKSTEALINGDEQUE_HPP